@@ -31,9 +31,11 @@ int main(int argc, char *argv[]) {
     static std::string output = "out.png";
     std::string cache_file = "cache.sqlite";
     std::string asset_root = ".";
+    std::string shader_cache;
     std::vector<std::string> classes;
     std::string token;
     bool debug = false;
+    bool stats = false;
 
     po::options_description desc("Allowed options");
     desc.add_options()
@@ -47,9 +49,11 @@ int main(int argc, char *argv[]) {
         ("class,c", po::value(&classes)->value_name("name"), "Class name")
         ("token,t", po::value(&token)->value_name("key")->default_value(token), "Mapbox access token")
         ("debug", po::bool_switch(&debug)->default_value(debug), "Debug mode")
+        ("stats", po::bool_switch(&stats)->default_value(stats), "Print draw call and state change counters")
         ("output,o", po::value(&output)->value_name("file")->default_value(output), "Output file name")
         ("cache,d", po::value(&cache_file)->value_name("file")->default_value(cache_file), "Cache database file name")
         ("assets,d", po::value(&asset_root)->value_name("file")->default_value(asset_root), "Directory to which asset:// URLs will resolve")
+        ("shader-cache", po::value(&shader_cache)->value_name("dir"), "Directory to store compiled shader programs in")
     ;
 
     try {
@@ -84,6 +88,10 @@ int main(int argc, char *argv[]) {
     HeadlessView view(pixelRatio, width, height);
     Map map(view, fileSource, MapMode::Still);
 
+    if (shader_cache.size()) {
+        map.setShaderCachePath(shader_cache);
+    }
+
     map.setStyleJSON(style, ".");
     map.setClasses(classes);
 
@@ -110,5 +118,23 @@ int main(int argc, char *argv[]) {
 
     loop.run();
 
+    if (stats) {
+        const auto print = [](const std::string& name, const RenderCounters& counters) {
+            std::cout << name
+                      << ": draw calls " << counters.drawCalls
+                      << ", program switches " << counters.programSwitches
+                      << ", state changes " << counters.stateChanges
+                      << ", texture binds " << counters.textureBinds
+                      << ", uniform uploads " << counters.uniformUploads
+                      << ", bytes uploaded " << counters.bytesUploaded << std::endl;
+        };
+
+        const RenderStatistics statistics = map.getRenderStatistics();
+        print("total", statistics.total);
+        for (const auto& layer : statistics.layers) {
+            print(layer.first, layer.second);
+        }
+    }
+
     return 0;
 }
@@ -110,6 +110,11 @@ public:
 using glProc = void (*)();
 void InitializeExtensions(glProc (*getProcAddress)(const char *));
 
+// Whether glDrawElements() accepts GL_UNSIGNED_INT indices. Desktop OpenGL always does; OpenGL ES 2.0
+// requires OES_element_index_uint, which is detected by InitializeExtensions(). Safe to call from
+// any thread.
+bool SupportsElementIndexUint();
+
 static gl::ExtensionFunction<
     void (GLuint array)>
     BindVertexArray({
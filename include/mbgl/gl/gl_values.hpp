@@ -144,6 +144,10 @@ struct StencilOp {
     }
 };
 
+inline bool operator!=(const StencilOp::Type& a, const StencilOp::Type& b) {
+    return a.sfail != b.sfail || a.dpfail != b.dpfail || a.dppass != b.dppass;
+}
+
 struct DepthRange {
     struct Type { GLfloat near, far; };
     static const Type Default;
@@ -214,6 +218,10 @@ struct BlendFunc {
     }
 };
 
+inline bool operator!=(const BlendFunc::Type& a, const BlendFunc::Type& b) {
+    return a.sfactor != b.sfactor || a.dfactor != b.dfactor;
+}
+
 struct Program {
     using Type = GLuint;
     static const Type Default;
@@ -0,0 +1,55 @@
+#ifndef MBGL_MAP_FRAME_PROFILE
+#define MBGL_MAP_FRAME_PROFILE
+
+#include <mbgl/util/chrono.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace mbgl {
+
+// Tile counts of a single source, by loading state.
+struct SourceProfile {
+    std::string id;
+
+    // Waiting for data from the network or the cache.
+    uint32_t loading = 0;
+    // Data arrived and is being parsed on a worker thread.
+    uint32_t parsing = 0;
+    // Parsed, but still waiting for glyphs or icons; renders with missing layers.
+    uint32_t partial = 0;
+    uint32_t parsed = 0;
+    // Parsed, but not uploaded to the GPU yet.
+    uint32_t pendingUpload = 0;
+    // Failed to load or no longer needed.
+    uint32_t invalid = 0;
+};
+
+// Breakdown of the CPU time the map thread spent on a frame. Phases that didn't run
+// for the frame are zero.
+struct FrameProfile {
+    // Style updates that happened since the previous frame.
+    Duration cascade = Duration::zero();
+    Duration recalculate = Duration::zero();
+    Duration sourceUpdate = Duration::zero();
+
+    // Rendering.
+    Duration upload = Duration::zero();
+    Duration clip = Duration::zero();
+    Duration opaquePass = Duration::zero();
+    Duration translucentPass = Duration::zero();
+    Duration debugPass = Duration::zero();
+
+    // All of the above, plus everything in between.
+    Duration total = Duration::zero();
+
+    std::vector<SourceProfile> sources;
+
+    // Number of tasks queued or running on each worker thread.
+    std::vector<std::size_t> workerQueueDepths;
+};
+
+} // namespace mbgl
+
+#endif
@@ -6,6 +6,8 @@
 #include <mbgl/util/image.hpp>
 #include <mbgl/map/update.hpp>
 #include <mbgl/map/mode.hpp>
+#include <mbgl/map/render_statistics.hpp>
+#include <mbgl/map/frame_profile.hpp>
 #include <mbgl/util/geo.hpp>
 #include <mbgl/util/noncopyable.hpp>
 #include <mbgl/util/vec.hpp>
@@ -174,6 +176,11 @@ public:
                         const char* before = nullptr);
     void removeCustomLayer(const std::string& id);
 
+    // Directory to store linked shader program binaries in, where the OpenGL driver supports
+    // retrieving them. Maps sharing the directory reuse each other's programs instead of
+    // compiling them again. Takes effect for shaders compiled after this call.
+    void setShaderCachePath(const std::string&);
+
     // Memory
     void setSourceTileCacheSize(size_t);
     void onLowMemory();
@@ -186,6 +193,14 @@ public:
     bool isFullyLoaded() const;
     void dumpDebugLogs() const;
 
+    // Draw calls, state changes and uploads issued for the most recently rendered frame.
+    RenderStatistics getRenderStatistics() const;
+
+    // Called on the map thread after every rendered frame with a breakdown of where the
+    // frame's time went. Pass an empty function to stop profiling.
+    using FrameProfileCallback = std::function<void (const FrameProfile&)>;
+    void setFrameProfileCallback(FrameProfileCallback);
+
 private:
     View& view;
     const std::unique_ptr<Transform> transform;
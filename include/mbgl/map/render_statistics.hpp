@@ -0,0 +1,54 @@
+#ifndef MBGL_MAP_RENDER_STATISTICS
+#define MBGL_MAP_RENDER_STATISTICS
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+namespace mbgl {
+
+// Counts the OpenGL work issued while rendering.
+struct RenderCounters {
+    uint32_t drawCalls = 0;
+    uint32_t programSwitches = 0;
+    // Changes to the remaining pipeline state: blending, depth, stencil, masks, etc.
+    uint32_t stateChanges = 0;
+    uint32_t textureBinds = 0;
+    uint32_t uniformUploads = 0;
+    // Vertex, index and texture data transferred to the GPU.
+    uint64_t bytesUploaded = 0;
+
+    RenderCounters& operator+=(const RenderCounters& other) {
+        drawCalls += other.drawCalls;
+        programSwitches += other.programSwitches;
+        stateChanges += other.stateChanges;
+        textureBinds += other.textureBinds;
+        uniformUploads += other.uniformUploads;
+        bytesUploaded += other.bytesUploaded;
+        return *this;
+    }
+
+    RenderCounters operator-(const RenderCounters& other) const {
+        RenderCounters result = *this;
+        result.drawCalls -= other.drawCalls;
+        result.programSwitches -= other.programSwitches;
+        result.stateChanges -= other.stateChanges;
+        result.textureBinds -= other.textureBinds;
+        result.uniformUploads -= other.uniformUploads;
+        result.bytesUploaded -= other.bytesUploaded;
+        return result;
+    }
+};
+
+// The work done for the most recently rendered frame.
+struct RenderStatistics {
+    RenderCounters total;
+
+    // Keyed by style layer ID. Only contains layers that were rendered. Uploads happen
+    // before any layer is rendered and are only included in the total.
+    std::unordered_map<std::string, RenderCounters> layers;
+};
+
+} // namespace mbgl
+
+#endif
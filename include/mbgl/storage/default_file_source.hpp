@@ -30,7 +30,14 @@ public:
     void setAccessToken(const std::string&);
     std::string getAccessToken() const;
 
+    /*
+     * Network concurrency limits; see the corresponding OnlineFileSource methods.
+     */
+    void setMaximumConcurrentRequests(uint32_t);
+    void setMaximumConnectionsPerHost(uint32_t);
+
     std::unique_ptr<AsyncRequest> request(const Resource&, Callback) override;
+    void setPriority(AsyncRequest&, Resource::Priority) override;
 
     /*
      * Retrieve all regions in the offline database.
@@ -108,6 +115,7 @@ public:
 private:
     const std::unique_ptr<util::Thread<Impl>> thread;
     const std::unique_ptr<FileSource> assetFileSource;
+    const std::unique_ptr<FileSource> mbtilesFileSource;
 };
 
 } // namespace mbgl
@@ -24,6 +24,10 @@ public:
     // If the request is cancelled before the callback is executed, the callback will
     // not be executed.
     virtual std::unique_ptr<AsyncRequest> request(const Resource&, Callback) = 0;
+
+    // Changes the priority of a request previously returned by this file source, e.g. when
+    // the tile it loads moves out of view. File sources that don't queue requests ignore it.
+    virtual void setPriority(AsyncRequest&, Resource::Priority) {}
 };
 
 } // namespace mbgl
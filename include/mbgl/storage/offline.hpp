@@ -31,6 +31,9 @@ public:
 
     /* Private */
     std::vector<TileID> tileCover(SourceType, uint16_t tileSize, const SourceInfo&) const;
+    std::vector<TileID> tileCover(int32_t z) const;
+    std::pair<int32_t, int32_t> coveringZoomRange(SourceType, uint16_t tileSize, const SourceInfo&) const;
+    uint64_t tileCount(SourceType, uint16_t tileSize, const SourceInfo&) const;
 
     const std::string styleURL;
     const LatLngBounds bounds;
@@ -115,6 +118,13 @@ public:
      */
     bool requiredResourceCountIsPrecise = false;
 
+    /**
+     * The average rate, in bytes per second, at which resources have been downloaded
+     * from the network since the download was last activated. Resources that were
+     * already present in the database do not contribute to this rate.
+     */
+    double downloadRate = 0;
+
     bool complete() const {
         return completedResourceCount == requiredResourceCount;
     }
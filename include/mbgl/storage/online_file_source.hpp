@@ -17,7 +17,16 @@ public:
     void setAccessToken(const std::string& t) { accessToken = t; }
     std::string getAccessToken() const { return accessToken; }
 
+    // Limits the number of requests in flight at once; further requests wait in a queue.
+    // Defaults to a value chosen for the platform's HTTP implementation.
+    void setMaximumConcurrentRequests(uint32_t);
+
+    // Limits the number of requests in flight to a single host; further requests for that
+    // host wait in the same queue, without holding up requests for other hosts. Defaults to 6.
+    void setMaximumConnectionsPerHost(uint32_t);
+
     std::unique_ptr<AsyncRequest> request(const Resource&, Callback) override;
+    void setPriority(AsyncRequest&, Resource::Priority) override;
 
 private:
     friend class OnlineFileRequestImpl;
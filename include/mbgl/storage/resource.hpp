@@ -20,6 +20,15 @@ public:
         SpriteJSON
     };
 
+    // Determines the order in which queued network requests are dispatched. Style, sprite and
+    // glyph requests default to High since nothing renders without them; tiles default to
+    // Regular. Prefetches such as offline downloads use Low.
+    enum Priority : uint8_t {
+        Low = 0,
+        Regular,
+        High
+    };
+
     struct TileData {
         std::string urlTemplate;
         uint8_t pixelRatio;
@@ -31,7 +40,8 @@ public:
     Resource(Kind kind_, const std::string& url_, optional<TileData> tileData_ = {})
         : kind(kind_),
           url(url_),
-          tileData(std::move(tileData_)) {
+          tileData(std::move(tileData_)),
+          priority(kind_ == Kind::Tile || kind_ == Kind::Unknown ? Priority::Regular : Priority::High) {
     }
 
     static Resource style(const std::string& url);
@@ -53,6 +63,8 @@ public:
     // Includes auxiliary data if this is a tile request.
     optional<TileData> tileData;
 
+    Priority priority;
+
     optional<SystemTimePoint> priorModified = {};
     optional<SystemTimePoint> priorExpires = {};
     optional<std::string> priorEtag = {};
@@ -1,14 +1,17 @@
 #include <mbgl/storage/default_file_source.hpp>
 #include <mbgl/storage/asset_file_source.hpp>
+#include <mbgl/storage/mbtiles_file_source.hpp>
 #include <mbgl/storage/online_file_source.hpp>
 #include <mbgl/storage/offline_database.hpp>
 #include <mbgl/storage/offline_download.hpp>
 
 #include <mbgl/platform/platform.hpp>
 #include <mbgl/util/url.hpp>
+#include <mbgl/util/string.hpp>
 #include <mbgl/util/thread.hpp>
 #include <mbgl/util/work_request.hpp>
 
+#include <algorithm>
 #include <cassert>
 
 namespace {
@@ -25,10 +28,17 @@ namespace mbgl {
 
 class DefaultFileSource::Impl {
 public:
+    // Requests for the same resource that are in flight at the same time share a single Task,
+    // and with it a single database lookup and a single online request. Each response is fanned
+    // out to all subscribers. Once the first online response arrived, the Task no longer takes
+    // new subscribers; later requests start a Task of their own that reads the database again.
     class Task {
     public:
-        Task(Resource resource, FileSource::Callback callback, DefaultFileSource::Impl* impl) {
-            auto offlineResponse = impl->offlineDatabase.get(resource);
+        Task(const std::string& key_, Resource resource, DefaultFileSource::Impl& impl_)
+            : key(key_),
+              impl(impl_),
+              priority(resource.priority) {
+            auto offlineResponse = impl.offlineDatabase.get(resource);
 
             Resource revalidation = resource;
 
@@ -36,15 +46,82 @@ public:
                 revalidation.priorModified = offlineResponse->modified;
                 revalidation.priorExpires = offlineResponse->expires;
                 revalidation.priorEtag = offlineResponse->etag;
-                callback(*offlineResponse);
+                response = *offlineResponse;
             }
 
-            onlineRequest = impl->onlineFileSource.request(revalidation, [=] (Response onlineResponse) {
-                impl->offlineDatabase.put(revalidation, onlineResponse);
-                callback(onlineResponse);
+            onlineRequest = impl.onlineFileSource.request(revalidation, [=] (Response onlineResponse) {
+                impl.offlineDatabase.put(revalidation, onlineResponse);
+                if (onlineResponse.notModified && response && response->data) {
+                    // The cached data is still current; only its freshness changed.
+                    response->expires = onlineResponse.expires;
+                    response->modified = onlineResponse.modified;
+                    response->etag = onlineResponse.etag;
+                } else {
+                    response = onlineResponse;
+                }
+                impl.settle(*this);
+                for (auto& subscriber : subscribers) {
+                    subscriber.second.callback(onlineResponse);
+                }
             });
         }
 
+        void subscribe(AsyncRequest* req, Resource::Priority priority_, FileSource::Callback callback) {
+            subscribers.emplace(req, Subscriber { priority_, callback });
+            updatePriority();
+
+            // Late subscribers immediately get the cached response, if there is one.
+            if (response) {
+                callback(*response);
+            }
+        }
+
+        void unsubscribe(AsyncRequest* req) {
+            subscribers.erase(req);
+            updatePriority();
+        }
+
+        void setPriority(AsyncRequest* req, Resource::Priority priority_) {
+            auto it = subscribers.find(req);
+            if (it != subscribers.end()) {
+                it->second.priority = priority_;
+                updatePriority();
+            }
+        }
+
+        bool hasSubscribers() const {
+            return !subscribers.empty();
+        }
+
+        const std::string key;
+
+    private:
+        struct Subscriber {
+            Resource::Priority priority;
+            FileSource::Callback callback;
+        };
+
+        // A shared request is as urgent as its most urgent subscriber.
+        void updatePriority() {
+            if (subscribers.empty()) {
+                return;
+            }
+
+            Resource::Priority highest = Resource::Priority::Low;
+            for (const auto& subscriber : subscribers) {
+                highest = std::max(highest, subscriber.second.priority);
+            }
+
+            if (highest != priority) {
+                priority = highest;
+                impl.onlineFileSource.setPriority(*onlineRequest, priority);
+            }
+        }
+
+        DefaultFileSource::Impl& impl;
+        Resource::Priority priority;
+        optional<Response> response;
+        std::unordered_map<AsyncRequest*, Subscriber> subscribers;
         std::unique_ptr<AsyncRequest> onlineRequest;
     };
 
@@ -60,6 +137,18 @@ public:
         return onlineFileSource.getAccessToken();
     }
 
+    void setMaximumConcurrentRequests(uint32_t maximum) {
+        onlineFileSource.setMaximumConcurrentRequests(maximum);
+        maximumConcurrentRequests = maximum;
+        for (auto& download : downloads) {
+            download.second->setMaximumConcurrentRequests(maximum);
+        }
+    }
+
+    void setMaximumConnectionsPerHost(uint32_t maximum) {
+        onlineFileSource.setMaximumConnectionsPerHost(maximum);
+    }
+
     void listRegions(std::function<void (std::exception_ptr, optional<std::vector<OfflineRegion>>)> callback) {
         try {
             callback({}, offlineDatabase.listRegions());
@@ -104,11 +193,43 @@ public:
     }
 
     void request(AsyncRequest* req, Resource resource, Callback callback) {
-        tasks[req] = std::make_unique<Task>(resource, callback, this);
+        const std::string key = taskKey(resource);
+        std::shared_ptr<Task> task = tasks[key].lock();
+        if (!task) {
+            task = std::make_shared<Task>(key, resource, *this);
+            tasks[key] = task;
+        }
+        subscriptions[req] = task;
+        task->subscribe(req, resource.priority, callback);
     }
 
     void cancel(AsyncRequest* req) {
-        tasks.erase(req);
+        auto it = subscriptions.find(req);
+        if (it == subscriptions.end()) {
+            return;
+        }
+
+        std::shared_ptr<Task> task = std::move(it->second);
+        subscriptions.erase(it);
+        task->unsubscribe(req);
+        if (!task->hasSubscribers()) {
+            settle(*task);
+        }
+    }
+
+    // Stops the task from taking new subscribers.
+    void settle(const Task& task) {
+        auto it = tasks.find(task.key);
+        if (it != tasks.end() && (it->second.expired() || it->second.lock().get() == &task)) {
+            tasks.erase(it);
+        }
+    }
+
+    void setPriority(AsyncRequest* req, Resource::Priority priority) {
+        auto it = subscriptions.find(req);
+        if (it != subscriptions.end()) {
+            it->second->setPriority(req, priority);
+        }
     }
 
     void setOfflineMapboxTileCountLimit(uint64_t limit) {
@@ -120,19 +241,39 @@ public:
     }
 
 private:
+    // Identifies requests that can share a Task. Tiles also include the tile coordinates,
+    // since those, and not the URL, determine where the tile is stored in the database.
+    static std::string taskKey(const Resource& resource) {
+        std::string key = util::toString(uint8_t(resource.kind)) + ":" + resource.url;
+        if (resource.tileData) {
+            const Resource::TileData& tile = *resource.tileData;
+            key += "\n" + tile.urlTemplate + "\n" + util::toString(tile.pixelRatio) + "/" +
+                util::toString(tile.z) + "/" + util::toString(tile.x) + "/" + util::toString(tile.y);
+        }
+        return key;
+    }
+
     OfflineDownload& getDownload(int64_t regionID) {
         auto it = downloads.find(regionID);
         if (it != downloads.end()) {
             return *it->second;
         }
-        return *downloads.emplace(regionID,
+        OfflineDownload& download = *downloads.emplace(regionID,
             std::make_unique<OfflineDownload>(regionID, offlineDatabase.getRegionDefinition(regionID), offlineDatabase, onlineFileSource)).first->second;
+        if (maximumConcurrentRequests) {
+            download.setMaximumConcurrentRequests(*maximumConcurrentRequests);
+        }
+        return download;
     }
 
     OfflineDatabase offlineDatabase;
     OnlineFileSource onlineFileSource;
-    std::unordered_map<AsyncRequest*, std::unique_ptr<Task>> tasks;
+    // Tasks that are still waiting for their first online response, by key. The subscriptions
+    // own the tasks.
+    std::unordered_map<std::string, std::weak_ptr<Task>> tasks;
+    std::unordered_map<AsyncRequest*, std::shared_ptr<Task>> subscriptions;
     std::unordered_map<int64_t, std::unique_ptr<OfflineDownload>> downloads;
+    optional<uint32_t> maximumConcurrentRequests;
 };
 
 DefaultFileSource::DefaultFileSource(const std::string& cachePath,
@@ -140,7 +281,8 @@ DefaultFileSource::DefaultFileSource(const std::string& cachePath,
                                      uint64_t maximumCacheSize)
     : thread(std::make_unique<util::Thread<Impl>>(util::ThreadContext{"DefaultFileSource", util::ThreadType::Unknown, util::ThreadPriority::Low},
             cachePath, maximumCacheSize)),
-      assetFileSource(std::make_unique<AssetFileSource>(assetRoot)) {
+      assetFileSource(std::make_unique<AssetFileSource>(assetRoot)),
+      mbtilesFileSource(std::make_unique<MBTilesFileSource>()) {
 }
 
 DefaultFileSource::~DefaultFileSource() = default;
@@ -153,6 +295,14 @@ std::string DefaultFileSource::getAccessToken() const {
     return thread->invokeSync<std::string>(&Impl::getAccessToken);
 }
 
+void DefaultFileSource::setMaximumConcurrentRequests(uint32_t maximum) {
+    thread->invoke(&Impl::setMaximumConcurrentRequests, maximum);
+}
+
+void DefaultFileSource::setMaximumConnectionsPerHost(uint32_t maximum) {
+    thread->invoke(&Impl::setMaximumConnectionsPerHost, maximum);
+}
+
 std::unique_ptr<AsyncRequest> DefaultFileSource::request(const Resource& resource, Callback callback) {
     class DefaultFileRequest : public AsyncRequest {
     public:
@@ -171,11 +321,18 @@ std::unique_ptr<AsyncRequest> DefaultFileSource::request(const Resource& resourc
 
     if (isAssetURL(resource.url)) {
         return assetFileSource->request(resource, callback);
+    } else if (MBTilesFileSource::acceptsURL(resource.url)) {
+        return mbtilesFileSource->request(resource, callback);
     } else {
         return std::make_unique<DefaultFileRequest>(resource, callback, *thread);
     }
 }
 
+void DefaultFileSource::setPriority(AsyncRequest& req, Resource::Priority priority) {
+    // Asset and MBTiles requests are never queued, so they simply won't be found.
+    thread->invoke(&Impl::setPriority, &req, priority);
+}
+
 void DefaultFileSource::listOfflineRegions(std::function<void (std::exception_ptr, optional<std::vector<OfflineRegion>>)> callback) {
     thread->invoke(&Impl::listRegions, callback);
 }
@@ -36,6 +36,12 @@ void handleError(CURLcode code) {
     }
 }
 
+void handleError(CURLSHcode code) {
+    if (code != CURLSHE_OK) {
+        throw std::runtime_error(std::string("CURL share error: ") + curl_share_strerror(code));
+    }
+}
+
 namespace mbgl {
 
 class HTTPCURLRequest;
@@ -117,6 +123,19 @@ HTTPCURLContext::HTTPCURLContext() {
     handleError(curl_multi_setopt(multi, CURLMOPT_SOCKETDATA, this));
     handleError(curl_multi_setopt(multi, CURLMOPT_TIMERFUNCTION, startTimeout));
     handleError(curl_multi_setopt(multi, CURLMOPT_TIMERDATA, this));
+
+#if LIBCURL_VERSION_NUM >= ((7) << 16 | (43) << 8 | 0) // Added in 7.43.0
+    // Multiplex requests to the same host over a single HTTP/2 connection when the
+    // server supports it, instead of opening (and TLS handshaking) one per request.
+    handleError(curl_multi_setopt(multi, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX));
+#endif
+
+    // Share DNS lookups and TLS sessions between easy handles, so that new connections to
+    // a host we've already talked to can skip the resolve and resume the TLS session.
+    handleError(curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS));
+#if LIBCURL_VERSION_NUM >= ((7) << 16 | (23) << 8 | 0) // Added in 7.23.0
+    handleError(curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION));
+#endif
 }
 
 HTTPCURLContext::~HTTPCURLContext() {
@@ -389,6 +408,15 @@ HTTPCURLRequest::HTTPCURLRequest(HTTPCURLContext* context_, const Resource& reso
 #endif
     handleError(curl_easy_setopt(handle, CURLOPT_USERAGENT, "MapboxGL/1.0"));
     handleError(curl_easy_setopt(handle, CURLOPT_SHARE, context->share));
+#if LIBCURL_VERSION_NUM >= ((7) << 16 | (47) << 8 | 0) // Added in 7.47.0
+    // Negotiate HTTP/2 via ALPN for https:// URLs; plain http:// stays on HTTP/1.1. This
+    // fails gracefully if libcurl was built without HTTP/2 support.
+    curl_easy_setopt(handle, CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_2TLS);
+#endif
+#if LIBCURL_VERSION_NUM >= ((7) << 16 | (43) << 8 | 0) // Added in 7.43.0
+    // Prefer waiting for a connection that can be multiplexed over opening a new one.
+    handleError(curl_easy_setopt(handle, CURLOPT_PIPEWAIT, 1L));
+#endif
 
     // Start requesting the information.
     handleError(curl_multi_add_handle(context->multi, handle));
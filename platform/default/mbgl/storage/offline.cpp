@@ -23,7 +23,7 @@ OfflineTilePyramidRegionDefinition::OfflineTilePyramidRegionDefinition(
     }
 }
 
-std::vector<TileID> OfflineTilePyramidRegionDefinition::tileCover(SourceType type, uint16_t tileSize, const SourceInfo& info) const {
+std::pair<int32_t, int32_t> OfflineTilePyramidRegionDefinition::coveringZoomRange(SourceType type, uint16_t tileSize, const SourceInfo& info) const {
     double minZ = std::max<double>(coveringZoomLevel(minZoom, type, tileSize), info.minZoom);
     double maxZ = std::min<double>(coveringZoomLevel(maxZoom, type, tileSize), info.maxZoom);
 
@@ -32,17 +32,44 @@ std::vector<TileID> OfflineTilePyramidRegionDefinition::tileCover(SourceType typ
     assert(minZ < std::numeric_limits<uint8_t>::max());
     assert(maxZ < std::numeric_limits<uint8_t>::max());
 
+    return { static_cast<int32_t>(minZ), static_cast<int32_t>(maxZ) };
+}
+
+std::vector<TileID> OfflineTilePyramidRegionDefinition::tileCover(int32_t z) const {
+    std::vector<TileID> result;
+
+    for (const auto& tile : mbgl::tileCover(bounds, z, z)) {
+        result.push_back(tile.normalized());
+    }
+
+    return result;
+}
+
+std::vector<TileID> OfflineTilePyramidRegionDefinition::tileCover(SourceType type, uint16_t tileSize, const SourceInfo& info) const {
+    const auto range = coveringZoomRange(type, tileSize, info);
+
     std::vector<TileID> result;
 
-    for (uint8_t z = minZ; z <= maxZ; z++) {
-        for (const auto& tile : mbgl::tileCover(bounds, z, z)) {
-            result.push_back(tile.normalized());
+    for (int32_t z = range.first; z <= range.second; z++) {
+        for (const auto& tile : tileCover(z)) {
+            result.push_back(tile);
         }
     }
 
     return result;
 }
 
+uint64_t OfflineTilePyramidRegionDefinition::tileCount(SourceType type, uint16_t tileSize, const SourceInfo& info) const {
+    const auto range = coveringZoomRange(type, tileSize, info);
+
+    uint64_t result = 0;
+    for (int32_t z = range.first; z <= range.second; z++) {
+        result += mbgl::tileCount(bounds, z);
+    }
+
+    return result;
+}
+
 OfflineRegionDefinition decodeOfflineRegionDefinition(const std::string& region) {
     rapidjson::GenericDocument<rapidjson::UTF8<>, rapidjson::CrtAllocator> doc;
     doc.Parse<0>(region.c_str());
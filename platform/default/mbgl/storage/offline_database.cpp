@@ -197,6 +197,26 @@ optional<std::pair<Response, uint64_t>> OfflineDatabase::getResource(const Resou
     return std::make_pair(response, size);
 }
 
+optional<uint64_t> OfflineDatabase::hasResource(const Resource& resource) {
+    Statement accessedStmt = getStatement(
+        "UPDATE resources SET accessed = ?1 WHERE url = ?2");
+
+    accessedStmt->bind(1, SystemClock::now());
+    accessedStmt->bind(2, resource.url);
+    accessedStmt->run();
+
+    Statement stmt = getStatement("SELECT LENGTH(data) FROM resources WHERE url = ?");
+
+    stmt->bind(1, resource.url);
+
+    if (!stmt->run()) {
+        return {};
+    }
+
+    optional<int64_t> size = stmt->get<optional<int64_t>>(0);
+    return size ? uint64_t(*size) : 0;
+}
+
 bool OfflineDatabase::putResource(const Resource& resource,
                                   const Response& response,
                                   const std::string& data,
@@ -330,6 +350,47 @@ optional<std::pair<Response, uint64_t>> OfflineDatabase::getTile(const Resource:
     return std::make_pair(response, size);
 }
 
+optional<uint64_t> OfflineDatabase::hasTile(const Resource::TileData& tile) {
+    Statement accessedStmt = getStatement(
+        "UPDATE tiles "
+        "SET accessed       = ?1 "
+        "WHERE url_template = ?2 "
+        "  AND pixel_ratio  = ?3 "
+        "  AND x            = ?4 "
+        "  AND y            = ?5 "
+        "  AND z            = ?6 ");
+
+    accessedStmt->bind(1, SystemClock::now());
+    accessedStmt->bind(2, tile.urlTemplate);
+    accessedStmt->bind(3, tile.pixelRatio);
+    accessedStmt->bind(4, tile.x);
+    accessedStmt->bind(5, tile.y);
+    accessedStmt->bind(6, tile.z);
+    accessedStmt->run();
+
+    Statement stmt = getStatement(
+        "SELECT LENGTH(data) "
+        "FROM tiles "
+        "WHERE url_template = ?1 "
+        "  AND pixel_ratio  = ?2 "
+        "  AND x            = ?3 "
+        "  AND y            = ?4 "
+        "  AND z            = ?5 ");
+
+    stmt->bind(1, tile.urlTemplate);
+    stmt->bind(2, tile.pixelRatio);
+    stmt->bind(3, tile.x);
+    stmt->bind(4, tile.y);
+    stmt->bind(5, tile.z);
+
+    if (!stmt->run()) {
+        return {};
+    }
+
+    optional<int64_t> size = stmt->get<optional<int64_t>>(0);
+    return size ? uint64_t(*size) : 0;
+}
+
 bool OfflineDatabase::putTile(const Resource::TileData& tile,
                               const Response& response,
                               const std::string& data,
@@ -487,6 +548,39 @@ uint64_t OfflineDatabase::putRegionResource(int64_t regionID, const Resource& re
     return size;
 }
 
+std::vector<optional<uint64_t>> OfflineDatabase::hasRegionResources(int64_t regionID, const std::vector<Resource>& resources) {
+    std::vector<optional<uint64_t>> result;
+    result.reserve(resources.size());
+
+    db->exec("BEGIN");
+
+    try {
+        for (const auto& resource : resources) {
+            optional<uint64_t> size;
+
+            if (resource.kind == Resource::Kind::Tile) {
+                assert(resource.tileData);
+                size = hasTile(*resource.tileData);
+            } else {
+                size = hasResource(resource);
+            }
+
+            if (size) {
+                markUsed(regionID, resource);
+            }
+
+            result.push_back(size);
+        }
+    } catch (...) {
+        db->exec("ROLLBACK");
+        throw;
+    }
+
+    db->exec("COMMIT");
+
+    return result;
+}
+
 bool OfflineDatabase::markUsed(int64_t regionID, const Resource& resource) {
     if (resource.kind == Resource::Kind::Tile) {
         Statement insert = getStatement(
@@ -48,6 +48,12 @@ public:
     optional<std::pair<Response, uint64_t>> getRegionResource(int64_t regionID, const Resource&);
     uint64_t putRegionResource(int64_t regionID, const Resource&, const Response&);
 
+    // Return value is the stored size of each resource that is present in the database,
+    // or nothing if it is absent. Present resources are marked as used by the region.
+    // Unlike getRegionResource, response data is not read, and all lookups share a
+    // single transaction.
+    std::vector<optional<uint64_t>> hasRegionResources(int64_t regionID, const std::vector<Resource>&);
+
     OfflineRegionDefinition getRegionDefinition(int64_t regionID);
     OfflineRegionStatus getRegionCompletedStatus(int64_t regionID);
 
@@ -80,7 +86,10 @@ private:
     bool putTile(const Resource::TileData&, const Response&,
                  const std::string&, bool compressed);
 
+    optional<uint64_t> hasTile(const Resource::TileData&);
+
     optional<std::pair<Response, uint64_t>> getResource(const Resource&);
+    optional<uint64_t> hasResource(const Resource&);
     bool putResource(const Resource&, const Response&,
                      const std::string&, bool compressed);
 
@@ -3,6 +3,7 @@
 #include <mbgl/storage/file_source.hpp>
 #include <mbgl/storage/resource.hpp>
 #include <mbgl/storage/response.hpp>
+#include <mbgl/storage/http_context_base.hpp>
 #include <mbgl/style/style_parser.hpp>
 #include <mbgl/layer/symbol_layer.hpp>
 #include <mbgl/text/glyph.hpp>
@@ -10,10 +11,16 @@
 #include <mbgl/util/mapbox.hpp>
 #include <mbgl/util/run_loop.hpp>
 
+#include <algorithm>
 #include <set>
+#include <iterator>
 
 namespace mbgl {
 
+// The number of queued resources whose presence in the database is checked per run loop
+// iteration. Bounds the time the database thread spends on any single batch.
+static const std::size_t batchSize = 256;
+
 OfflineDownload::OfflineDownload(int64_t id_,
                                  OfflineRegionDefinition&& definition_,
                                  OfflineDatabase& offlineDatabase_,
@@ -21,7 +28,8 @@ OfflineDownload::OfflineDownload(int64_t id_,
     : id(id_),
       definition(definition_),
       offlineDatabase(offlineDatabase_),
-      onlineFileSource(onlineFileSource_) {
+      onlineFileSource(onlineFileSource_),
+      maximumConcurrentRequests(HTTPContextBase::maximumConcurrentRequests()) {
     setObserver(nullptr);
 }
 
@@ -31,6 +39,11 @@ void OfflineDownload::setObserver(std::unique_ptr<OfflineRegionObserver> observe
     observer = observer_ ? std::move(observer_) : std::make_unique<OfflineRegionObserver>();
 }
 
+void OfflineDownload::setMaximumConcurrentRequests(std::size_t maximum) {
+    maximumConcurrentRequests = std::max<std::size_t>(maximum, 1);
+    scheduleContinueDownload();
+}
+
 void OfflineDownload::setState(OfflineRegionDownloadState state) {
     if (status.downloadState == state) {
         return;
@@ -72,16 +85,6 @@ std::vector<Resource> OfflineDownload::glyphResources(const StyleParser& parser)
     return result;
 }
 
-std::vector<Resource> OfflineDownload::tileResources(SourceType type, uint16_t tileSize, const SourceInfo& info) const {
-    std::vector<Resource> result;
-
-    for (const auto& tile : definition.tileCover(type, tileSize, info)) {
-        result.push_back(Resource::tile(info.tiles[0], definition.pixelRatio, tile.x, tile.y, tile.z));
-    }
-
-    return result;
-}
-
 OfflineRegionStatus OfflineDownload::getStatus() const {
     if (status.downloadState == OfflineRegionDownloadState::Active) {
         return status;
@@ -105,13 +108,13 @@ OfflineRegionStatus OfflineDownload::getStatus() const {
         case SourceType::Vector:
         case SourceType::Raster:
             if (source->getInfo()) {
-                result.requiredResourceCount += tileResources(source->type, source->tileSize, *source->getInfo()).size();
+                result.requiredResourceCount += definition.tileCount(source->type, source->tileSize, *source->getInfo());
             } else {
                 result.requiredResourceCount += 1;
                 optional<Response> sourceResponse = offlineDatabase.get(Resource::source(source->url));
                 if (sourceResponse) {
-                    result.requiredResourceCount += tileResources(source->type, source->tileSize,
-                        *StyleParser::parseTileJSON(*sourceResponse->data, source->url, source->type, source->tileSize)).size();
+                    result.requiredResourceCount += definition.tileCount(source->type, source->tileSize,
+                        *StyleParser::parseTileJSON(*sourceResponse->data, source->url, source->type, source->tileSize));
                 } else {
                     result.requiredResourceCountIsPrecise = false;
                 }
@@ -141,6 +144,8 @@ void OfflineDownload::activateDownload() {
     status.downloadState = OfflineRegionDownloadState::Active;
 
     requiredSourceURLs.clear();
+    activated = Clock::now();
+    downloadedSize = 0;
 
     ensureResource(Resource::style(definition.styleURL), [&] (Response styleResponse) {
         status.requiredResourceCountIsPrecise = true;
@@ -197,69 +202,194 @@ void OfflineDownload::activateDownload() {
 
 void OfflineDownload::deactivateDownload() {
     requests.clear();
+    continueRequest.reset();
+    resourcesRemaining.clear();
+    resourcesMissing.clear();
+    tilesRemaining.clear();
 }
 
 void OfflineDownload::ensureTiles(SourceType type, uint16_t tileSize, const SourceInfo& info) {
-    for (const auto& resource : tileResources(type, tileSize, info)) {
-        ensureResource(resource);
+    const auto range = definition.coveringZoomRange(type, tileSize, info);
+    if (range.first > range.second) {
+        return;
     }
+
+    status.requiredResourceCount += definition.tileCount(type, tileSize, info);
+    tilesRemaining.push_back({ info.tiles[0], range.first, range.second, {}, 0 });
+    scheduleContinueDownload();
 }
 
 void OfflineDownload::ensureResource(const Resource& resource, std::function<void (Response)> callback) {
     status.requiredResourceCount++;
 
+    if (!callback) {
+        resourcesRemaining.push_back(resource);
+        scheduleContinueDownload();
+        return;
+    }
+
+    // Resources with a callback need their response data, so they bypass the batched
+    // existence check.
     auto workRequestsIt = requests.insert(requests.begin(), nullptr);
     *workRequestsIt = util::RunLoop::Get()->invokeCancellable([=] () {
         requests.erase(workRequestsIt);
 
         optional<std::pair<Response, uint64_t>> offlineResponse = offlineDatabase.getRegionResource(id, resource);
         if (offlineResponse) {
-            if (callback) {
-                callback(offlineResponse->first);
-            }
+            callback(offlineResponse->first);
+            resourceCompleted(offlineResponse->second, false);
+            return;
+        }
 
-            status.completedResourceCount++;
-            status.completedResourceSize += offlineResponse->second;
-            observer->statusChanged(status);
-            
-            if (status.complete()) {
-                setState(OfflineRegionDownloadState::Inactive);
-            }
+        requestResource(resource, callback);
+    });
+}
 
-            return;
+void OfflineDownload::scheduleContinueDownload() {
+    if (status.downloadState == OfflineRegionDownloadState::Active && !continueRequest) {
+        continueRequest = util::RunLoop::Get()->invokeCancellable([this] () {
+            continueRequest.reset();
+            continueDownload();
+        });
+    }
+}
+
+optional<Resource> OfflineDownload::nextResource() {
+    if (!resourcesRemaining.empty()) {
+        Resource resource = std::move(resourcesRemaining.front());
+        resourcesRemaining.pop_front();
+        return resource;
+    }
+
+    while (!tilesRemaining.empty()) {
+        TileQueue& queue = tilesRemaining.front();
+
+        if (queue.index < queue.tiles.size()) {
+            const TileID& tile = queue.tiles[queue.index++];
+            return Resource::tile(queue.urlTemplate, definition.pixelRatio, tile.x, tile.y, tile.z);
         }
 
-        if (resource.kind == Resource::Kind::Tile
-            && util::mapbox::isMapboxURL(resource.url)
-            && offlineDatabase.offlineMapboxTileCountLimitExceeded()) {
-            observer->mapboxTileCountLimitExceeded(offlineDatabase.getOfflineMapboxTileCountLimit());
-            setState(OfflineRegionDownloadState::Inactive);
-            return;
+        if (queue.z > queue.maxZ) {
+            tilesRemaining.pop_front();
+            continue;
+        }
+
+        queue.tiles = definition.tileCover(queue.z++);
+        queue.index = 0;
+    }
+
+    return {};
+}
+
+void OfflineDownload::continueDownload() {
+    const std::size_t maximumRequests = maximumConcurrentRequests;
+
+    if (!requestMissingResources(maximumRequests)) {
+        return;
+    }
+
+    // Apply backpressure: while the request window is full, wait for a request to
+    // complete, which schedules the next batch.
+    if (requests.size() >= maximumRequests) {
+        return;
+    }
+
+    std::vector<Resource> batch;
+    batch.reserve(batchSize);
+
+    while (batch.size() < batchSize) {
+        optional<Resource> resource = nextResource();
+        if (!resource) {
+            break;
         }
+        batch.push_back(std::move(*resource));
+    }
+
+    if (batch.empty()) {
+        return;
+    }
+
+    const std::vector<optional<uint64_t>> sizes = offlineDatabase.hasRegionResources(id, batch);
 
-        auto fileRequestsIt = requests.insert(requests.begin(), nullptr);
-        *fileRequestsIt = onlineFileSource.request(resource, [=] (Response onlineResponse) {
-            if (onlineResponse.error) {
-                observer->responseError(*onlineResponse.error);
+    for (std::size_t i = 0; i < batch.size(); i++) {
+        if (sizes[i]) {
+            resourceCompleted(*sizes[i], false);
+            if (status.downloadState != OfflineRegionDownloadState::Active) {
                 return;
             }
+        } else {
+            resourcesMissing.push_back(std::move(batch[i]));
+        }
+    }
 
-            requests.erase(fileRequestsIt);
+    if (!requestMissingResources(maximumRequests)) {
+        return;
+    }
 
-            if (callback) {
-                callback(onlineResponse);
-            }
+    scheduleContinueDownload();
+}
 
-            status.completedResourceCount++;
-            status.completedResourceSize += offlineDatabase.putRegionResource(id, resource, onlineResponse);
+bool OfflineDownload::requestMissingResources(std::size_t maximumRequests) {
+    // These were already checked against the database, so they are requested as soon as
+    // the request window has room, without checking them again.
+    while (!resourcesMissing.empty() && requests.size() < maximumRequests) {
+        Resource resource = std::move(resourcesMissing.front());
+        resourcesMissing.pop_front();
+        requestResource(resource, {});
+        if (status.downloadState != OfflineRegionDownloadState::Active) {
+            return false;
+        }
+    }
+    return true;
+}
 
-            observer->statusChanged(status);
-            
-            if (status.complete()) {
-                setState(OfflineRegionDownloadState::Inactive);
-            }
-        });
+void OfflineDownload::requestResource(const Resource& resource, std::function<void (Response)> callback) {
+    if (resource.kind == Resource::Kind::Tile
+        && util::mapbox::isMapboxURL(resource.url)
+        && offlineDatabase.offlineMapboxTileCountLimitExceeded()) {
+        observer->mapboxTileCountLimitExceeded(offlineDatabase.getOfflineMapboxTileCountLimit());
+        setState(OfflineRegionDownloadState::Inactive);
+        return;
+    }
+
+    // Region downloads are prefetches; let requests for what's on screen go first.
+    Resource prefetch = resource;
+    prefetch.priority = Resource::Priority::Low;
+
+    auto fileRequestsIt = requests.insert(requests.begin(), nullptr);
+    *fileRequestsIt = onlineFileSource.request(prefetch, [=] (Response onlineResponse) {
+        if (onlineResponse.error) {
+            observer->responseError(*onlineResponse.error);
+            return;
+        }
+
+        requests.erase(fileRequestsIt);
+
+        if (callback) {
+            callback(onlineResponse);
+        }
+
+        resourceCompleted(offlineDatabase.putRegionResource(id, resource, onlineResponse), true);
     });
 }
 
+void OfflineDownload::resourceCompleted(uint64_t size, bool downloaded) {
+    status.completedResourceCount++;
+    status.completedResourceSize += size;
+
+    if (downloaded) {
+        downloadedSize += size;
+        const double elapsed = std::chrono::duration<double>(Clock::now() - activated).count();
+        status.downloadRate = elapsed > 0 ? downloadedSize / elapsed : 0;
+    }
+
+    observer->statusChanged(status);
+
+    if (status.complete()) {
+        setState(OfflineRegionDownloadState::Inactive);
+    } else {
+        scheduleContinueDownload();
+    }
+}
+
 } // namespace mbgl
@@ -1,10 +1,14 @@
     #pragma once
 
 #include <mbgl/storage/offline.hpp>
+#include <mbgl/storage/resource.hpp>
 #include <mbgl/style/types.hpp>
+#include <mbgl/map/tile_id.hpp>
+#include <mbgl/util/chrono.hpp>
 
 #include <list>
 #include <set>
+#include <deque>
 #include <memory>
 
 namespace mbgl {
@@ -12,7 +16,6 @@ namespace mbgl {
 class OfflineDatabase;
 class FileSource;
 class AsyncRequest;
-class Resource;
 class Response;
 class SourceInfo;
 class StyleParser;
@@ -31,6 +34,10 @@ public:
     void setObserver(std::unique_ptr<OfflineRegionObserver>);
     void setState(OfflineRegionDownloadState);
 
+    // Limits the number of requests the download keeps in flight. Defaults to the limit of
+    // the platform's HTTP implementation.
+    void setMaximumConcurrentRequests(std::size_t);
+
     OfflineRegionStatus getStatus() const;
 
 private:
@@ -39,16 +46,33 @@ private:
 
     std::vector<Resource> spriteResources(const StyleParser&) const;
     std::vector<Resource> glyphResources(const StyleParser&) const;
-    std::vector<Resource> tileResources(SourceType, uint16_t, const SourceInfo&) const;
 
     /*
-     * Ensure that the resource is stored in the database, requesting it if necessary.
-     * While the request is in progress, it is recorded in `requests`. If the download
-     * is deactivated, all in progress requests are cancelled.
+     * Queue the resource for download. Resources are taken from the queue in batches,
+     * whose existence in the database is checked in a single transaction; resources
+     * that are missing are requested, keeping no more than a bounded number of requests
+     * in flight. If the download is deactivated, all in progress requests are cancelled.
      */
     void ensureResource(const Resource&, std::function<void (Response)> = {});
     void ensureTiles(SourceType, uint16_t, const SourceInfo&);
 
+    void scheduleContinueDownload();
+    void continueDownload();
+    optional<Resource> nextResource();
+    bool requestMissingResources(std::size_t maximumRequests);
+    void requestResource(const Resource&, std::function<void (Response)>);
+    void resourceCompleted(uint64_t size, bool downloaded);
+
+    // The tiles of a single source, enumerated one zoom level at a time so that the
+    // cover of the entire pyramid is never held in memory.
+    struct TileQueue {
+        std::string urlTemplate;
+        int32_t z;
+        int32_t maxZ;
+        std::vector<TileID> tiles;
+        std::size_t index;
+    };
+
     int64_t id;
     OfflineRegionDefinition definition;
     OfflineDatabase& offlineDatabase;
@@ -56,7 +80,15 @@ private:
     OfflineRegionStatus status;
     std::unique_ptr<OfflineRegionObserver> observer;
     std::list<std::unique_ptr<AsyncRequest>> requests;
+    std::unique_ptr<AsyncRequest> continueRequest;
+    std::deque<Resource> resourcesRemaining;
+    // Resources known to be missing from the database, waiting for room in the request window.
+    std::deque<Resource> resourcesMissing;
+    std::deque<TileQueue> tilesRemaining;
     std::set<std::string> requiredSourceURLs;
+    std::size_t maximumConcurrentRequests;
+    TimePoint activated;
+    uint64_t downloadedSize = 0;
 };
 
 } // namespace mbgl
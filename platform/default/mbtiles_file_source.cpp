@@ -0,0 +1,200 @@
+#include <mbgl/storage/mbtiles_file_source.hpp>
+#include <mbgl/storage/resource.hpp>
+#include <mbgl/storage/response.hpp>
+#include <mbgl/util/compression.hpp>
+#include <mbgl/util/string.hpp>
+#include <mbgl/util/thread.hpp>
+#include <mbgl/util/url.hpp>
+
+#include "sqlite3.hpp"
+#include <sqlite3.h>
+
+#include <rapidjson/document.h>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+
+#include <unordered_map>
+
+namespace {
+
+const std::string mbtilesProtocol = "mbtiles://";
+
+// Upper bound on the portion of each archive that SQLite maps into memory. Pages
+// within this range are read directly from the mapping instead of through read(2).
+const int64_t maximumMmapSize = int64_t(1) << 30;
+
+bool isCompressed(const std::string& data) {
+    // gzip or zlib header.
+    return data.size() >= 2 &&
+        ((uint8_t(data[0]) == 0x1F && uint8_t(data[1]) == 0x8B) ||
+         (uint8_t(data[0]) == 0x78 && (uint8_t(data[0]) * 256 + uint8_t(data[1])) % 31 == 0));
+}
+
+} // namespace
+
+namespace mbgl {
+
+using namespace mapbox::sqlite;
+
+class MBTilesFileSource::Impl {
+public:
+    class Archive {
+    public:
+        Archive(const std::string& path)
+            : db(path.c_str(), ReadOnly) {
+            db.exec("PRAGMA mmap_size = " + util::toString(maximumMmapSize));
+        }
+
+        Database db;
+        std::unique_ptr<Statement> tileStmt;
+    };
+
+    void request(const Resource& resource, FileSource::Callback callback) {
+        Response response;
+
+        // The URL has no host, so the path starts right after the protocol: mbtiles:///path.
+        if (resource.url.size() <= mbtilesProtocol.size() || resource.url[mbtilesProtocol.size()] != '/') {
+            response.error = std::make_unique<Response::Error>(
+                Response::Error::Reason::Other,
+                "MBTiles URL must have the form mbtiles:///path/to/archive.mbtiles");
+            callback(response);
+            return;
+        }
+
+        try {
+            Archive& archive = getArchive(util::percentDecode(resource.url.substr(mbtilesProtocol.size())));
+
+            if (resource.kind == Resource::Kind::Tile && resource.tileData) {
+                readTile(archive, *resource.tileData, response);
+            } else if (resource.kind == Resource::Kind::Source) {
+                response.data = std::make_shared<std::string>(readTileJSON(archive, resource.url));
+            } else {
+                response.error = std::make_unique<Response::Error>(Response::Error::Reason::NotFound);
+            }
+        } catch (const mapbox::sqlite::Exception& ex) {
+            response.error = std::make_unique<Response::Error>(
+                ex.code == SQLITE_CANTOPEN ? Response::Error::Reason::NotFound : Response::Error::Reason::Other,
+                ex.what());
+        } catch (...) {
+            response.error = std::make_unique<Response::Error>(
+                Response::Error::Reason::Other,
+                util::toString(std::current_exception()));
+        }
+
+        callback(response);
+    }
+
+private:
+    Archive& getArchive(const std::string& path) {
+        auto it = archives.find(path);
+        if (it != archives.end()) {
+            return *it->second;
+        }
+
+        return *archives.emplace(path, std::make_unique<Archive>(path)).first->second;
+    }
+
+    void readTile(Archive& archive, const Resource::TileData& tile, Response& response) {
+        if (!archive.tileStmt) {
+            archive.tileStmt = std::make_unique<Statement>(archive.db.prepare(
+                "SELECT tile_data "
+                "FROM tiles "
+                "WHERE zoom_level = ?1 "
+                "  AND tile_column = ?2 "
+                "  AND tile_row = ?3 "));
+        }
+
+        Statement& stmt = *archive.tileStmt;
+        stmt.reset();
+
+        // MBTiles uses TMS row numbering, with row 0 at the south edge.
+        stmt.bind(1, int32_t(tile.z));
+        stmt.bind(2, tile.x);
+        stmt.bind(3, (int32_t(1) << tile.z) - 1 - tile.y);
+
+        if (!stmt.run()) {
+            // Missing tiles are expected in sparse archives; treat them like a 404 for a tile.
+            response.noContent = true;
+            return;
+        }
+
+        std::string data = stmt.get<std::string>(0);
+        stmt.reset();
+
+        if (isCompressed(data)) {
+            response.data = std::make_shared<std::string>(util::decompress(data));
+        } else {
+            response.data = std::make_shared<std::string>(std::move(data));
+        }
+    }
+
+    std::string readTileJSON(Archive& archive, const std::string& url) {
+        std::unordered_map<std::string, std::string> metadata;
+
+        Statement stmt = archive.db.prepare("SELECT name, value FROM metadata");
+        while (stmt.run()) {
+            metadata.emplace(stmt.get<std::string>(0), stmt.get<std::string>(1));
+        }
+
+        rapidjson::GenericDocument<rapidjson::UTF8<>, rapidjson::CrtAllocator> doc;
+        doc.SetObject();
+
+        doc.AddMember("tilejson", "2.1.0", doc.GetAllocator());
+
+        rapidjson::GenericValue<rapidjson::UTF8<>, rapidjson::CrtAllocator> tiles(rapidjson::kArrayType);
+        tiles.PushBack(rapidjson::StringRef(url.data(), url.length()), doc.GetAllocator());
+        doc.AddMember("tiles", tiles, doc.GetAllocator());
+
+        auto minzoom = metadata.find("minzoom");
+        if (minzoom != metadata.end()) {
+            doc.AddMember("minzoom", std::stoi(minzoom->second), doc.GetAllocator());
+        }
+
+        auto maxzoom = metadata.find("maxzoom");
+        if (maxzoom != metadata.end()) {
+            doc.AddMember("maxzoom", std::stoi(maxzoom->second), doc.GetAllocator());
+        }
+
+        auto bounds = metadata.find("bounds");
+        if (bounds != metadata.end()) {
+            rapidjson::GenericValue<rapidjson::UTF8<>, rapidjson::CrtAllocator> array(rapidjson::kArrayType);
+            std::size_t start = 0;
+            for (int i = 0; i < 4 && start < bounds->second.size(); i++) {
+                std::size_t end = bounds->second.find(',', start);
+                array.PushBack(std::stod(bounds->second.substr(start, end - start)), doc.GetAllocator());
+                start = end == std::string::npos ? end : end + 1;
+            }
+            doc.AddMember("bounds", array, doc.GetAllocator());
+        }
+
+        auto attribution = metadata.find("attribution");
+        if (attribution != metadata.end()) {
+            doc.AddMember("attribution", rapidjson::StringRef(attribution->second.data(), attribution->second.length()), doc.GetAllocator());
+        }
+
+        rapidjson::StringBuffer buffer;
+        rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+        doc.Accept(writer);
+
+        return buffer.GetString();
+    }
+
+    std::unordered_map<std::string, std::unique_ptr<Archive>> archives;
+};
+
+MBTilesFileSource::MBTilesFileSource()
+    : thread(std::make_unique<util::Thread<Impl>>(
+        util::ThreadContext{"MBTilesFileSource", util::ThreadType::Worker, util::ThreadPriority::Regular})) {
+}
+
+MBTilesFileSource::~MBTilesFileSource() = default;
+
+std::unique_ptr<AsyncRequest> MBTilesFileSource::request(const Resource& resource, Callback callback) {
+    return thread->invokeWithCallback(&Impl::request, callback, resource);
+}
+
+bool MBTilesFileSource::acceptsURL(const std::string& url) {
+    return url.compare(0, mbtilesProtocol.size(), mbtilesProtocol) == 0;
+}
+
+} // namespace mbgl
@@ -15,6 +15,7 @@
 #include <mbgl/util/timer.hpp>
 
 #include <algorithm>
+#include <array>
 #include <cassert>
 #include <list>
 #include <unordered_set>
@@ -35,6 +36,7 @@ public:
 
     AsyncRequest* key;
     Resource resource;
+    const std::string host;
     HTTPRequestBase* request = nullptr;
     util::Timer timer;
     Callback callback;
@@ -66,15 +68,32 @@ public:
     }
 
     void cancel(AsyncRequest* key) {
-        allRequests.erase(key);
-        if (activeRequests.erase(key)) {
+        auto it = allRequests.find(key);
+        if (it != allRequests.end() && activeRequests.count(key)) {
+            deactivateRequest(it->second.get());
+            allRequests.erase(it);
             activatePendingRequest();
         } else {
-            auto it = pendingRequestsMap.find(key);
-            if (it != pendingRequestsMap.end()) {
-                pendingRequestsList.erase(it->second);
-                pendingRequestsMap.erase(it);
-            }
+            // Drop the request from the queue so that it never gets dispatched.
+            dequeueRequest(key);
+            allRequests.erase(key);
+        }
+    }
+
+    void setPriority(AsyncRequest* key, Resource::Priority priority) {
+        auto it = allRequests.find(key);
+        if (it == allRequests.end() || it->second->resource.priority == priority) {
+            return;
+        }
+
+        // A pending request moves to the back of the queue for its new priority; requests
+        // that are waiting for a timeout or already in flight just keep the new priority
+        // for the next time they're queued.
+        OnlineFileRequestImpl* impl = it->second.get();
+        const bool pending = dequeueRequest(key);
+        impl->resource.priority = priority;
+        if (pending) {
+            queueRequest(impl);
         }
     }
 
@@ -83,7 +102,7 @@ public:
         assert(activeRequests.find(impl->key) == activeRequests.end());
         assert(!impl->request);
 
-        if (activeRequests.size() >= HTTPContextBase::maximumConcurrentRequests()) {
+        if (activeRequests.size() >= maximumConcurrentRequests || isHostFull(impl->host)) {
             queueRequest(impl);
         } else {
             activateRequest(impl);
@@ -91,33 +110,85 @@ public:
     }
 
     void queueRequest(OnlineFileRequestImpl* impl) {
-        auto it = pendingRequestsList.insert(pendingRequestsList.end(), impl->key);
+        auto& list = pendingRequestsLists[impl->resource.priority];
+        auto it = list.insert(list.end(), impl->key);
         pendingRequestsMap.emplace(impl->key, std::move(it));
     }
 
+    bool dequeueRequest(AsyncRequest* key) {
+        auto it = pendingRequestsMap.find(key);
+        if (it == pendingRequestsMap.end()) {
+            return false;
+        }
+
+        auto impl = allRequests.find(key);
+        assert(impl != allRequests.end());
+        pendingRequestsLists[impl->second->resource.priority].erase(it->second);
+        pendingRequestsMap.erase(it);
+        return true;
+    }
+
     void activateRequest(OnlineFileRequestImpl* impl) {
         activeRequests.insert(impl->key);
+        activeRequestsPerHost[impl->host]++;
         impl->request = httpContext->createRequest(impl->resource, [=] (Response response) {
             impl->request = nullptr;
-            activeRequests.erase(impl->key);
+            deactivateRequest(impl);
             activatePendingRequest();
             impl->completed(*this, response);
         });
     }
 
-    void activatePendingRequest() {
-        if (pendingRequestsList.empty()) {
-            return;
+    void deactivateRequest(OnlineFileRequestImpl* impl) {
+        activeRequests.erase(impl->key);
+        auto it = activeRequestsPerHost.find(impl->host);
+        assert(it != activeRequestsPerHost.end());
+        if (--it->second == 0) {
+            activeRequestsPerHost.erase(it);
         }
+    }
+
+    bool isHostFull(const std::string& host) const {
+        auto it = activeRequestsPerHost.find(host);
+        return it != activeRequestsPerHost.end() && it->second >= maximumRequestsPerHost;
+    }
 
-        AsyncRequest* key = pendingRequestsList.front();
-        pendingRequestsList.pop_front();
+    void setMaximumConcurrentRequests(uint32_t maximum) {
+        maximumConcurrentRequests = std::max(maximum, 1u);
+        while (activatePendingRequest());
+    }
 
-        pendingRequestsMap.erase(key);
+    void setMaximumConnectionsPerHost(uint32_t maximum) {
+        maximumRequestsPerHost = std::max(maximum, 1u);
+        while (activatePendingRequest());
+    }
 
-        auto it = allRequests.find(key);
-        assert(it != allRequests.end());
-        activateRequest(it->second.get());
+    // Returns whether a request was dispatched.
+    bool activatePendingRequest() {
+        if (pendingRequestsMap.empty() || activeRequests.size() >= maximumConcurrentRequests) {
+            return false;
+        }
+
+        // Dispatch the oldest request of the highest priority whose host has room. Requests
+        // for a host that is at its limit stay queued in order, so that they're dispatched
+        // by priority once it has room again.
+        for (auto list = pendingRequestsLists.rbegin(); list != pendingRequestsLists.rend(); ++list) {
+            for (auto key = list->begin(); key != list->end(); ++key) {
+                auto it = allRequests.find(*key);
+                assert(it != allRequests.end());
+                OnlineFileRequestImpl* impl = it->second.get();
+                if (isHostFull(impl->host)) {
+                    continue;
+                }
+
+                pendingRequestsMap.erase(*key);
+                list->erase(key);
+                activateRequest(impl);
+                return true;
+            }
+        }
+
+        return false;
     }
 
 private:
@@ -131,17 +202,24 @@ private:
      * The lifetime of a request is:
      *
      * 1. Waiting for timeout (revalidation or retry)
-     * 2. Pending (waiting for room in the active set)
+     * 2. Pending (waiting for room in the active set, or for the request's host)
      * 3. Active (open network connection)
      * 4. Back to #1
      *
      * Requests in any state are in `allRequests`. Requests in the pending state are in
-     * `pendingRequests`. Requests in the active state are in `activeRequests`.
+     * `pendingRequestsMap` and in the `pendingRequestsLists` entry for their priority, which
+     * are dispatched highest priority first and in FIFO order within a priority. Requests in
+     * the active state are in `activeRequests`, and counted in `activeRequestsPerHost`.
      */
     std::unordered_map<AsyncRequest*, std::unique_ptr<OnlineFileRequestImpl>> allRequests;
-    std::list<AsyncRequest*> pendingRequestsList;
+    std::array<std::list<AsyncRequest*>, Resource::Priority::High + 1> pendingRequestsLists;
     std::unordered_map<AsyncRequest*, std::list<AsyncRequest*>::iterator> pendingRequestsMap;
     std::unordered_set<AsyncRequest*> activeRequests;
+    std::unordered_map<std::string, uint32_t> activeRequestsPerHost;
+    uint32_t maximumConcurrentRequests = HTTPContextBase::maximumConcurrentRequests();
+
+    // Matches the per-host limit of common browsers.
+    uint32_t maximumRequestsPerHost = 6;
 
     const std::unique_ptr<HTTPContextBase> httpContext { HTTPContextBase::createContext() };
     util::AsyncTask reachability { std::bind(&Impl::networkIsReachableAgain, this) };
@@ -154,6 +232,14 @@ OnlineFileSource::OnlineFileSource()
 
 OnlineFileSource::~OnlineFileSource() = default;
 
+void OnlineFileSource::setMaximumConcurrentRequests(uint32_t maximum) {
+    thread->invoke(&Impl::setMaximumConcurrentRequests, maximum);
+}
+
+void OnlineFileSource::setMaximumConnectionsPerHost(uint32_t maximum) {
+    thread->invoke(&Impl::setMaximumConnectionsPerHost, maximum);
+}
+
 std::unique_ptr<AsyncRequest> OnlineFileSource::request(const Resource& resource, Callback callback) {
     Resource res = resource;
 
@@ -201,9 +287,23 @@ std::unique_ptr<AsyncRequest> OnlineFileSource::request(const Resource& resource
     return std::make_unique<OnlineFileRequest>(res, callback, *thread);
 }
 
+void OnlineFileSource::setPriority(AsyncRequest& req, Resource::Priority priority) {
+    thread->invoke(&Impl::setPriority, &req, priority);
+}
+
+// Requests are limited per scheme and authority, e.g. "https://a.tiles.mapbox.com".
+static std::string requestHost(const std::string& url) {
+    const std::size_t start = url.find("://");
+    if (start == std::string::npos) {
+        return {};
+    }
+    return url.substr(0, url.find_first_of("/?#", start + 3));
+}
+
 OnlineFileRequestImpl::OnlineFileRequestImpl(AsyncRequest* key_, const Resource& resource_, Callback callback_, OnlineFileSource::Impl& impl)
     : key(key_),
       resource(resource_),
+      host(requestHost(resource.url)),
       callback(std::move(callback_)) {
     // Force an immediate first request if we don't have an expiration time.
     if (resource.priorExpires) {
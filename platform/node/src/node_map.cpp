@@ -91,6 +91,7 @@ NAN_MODULE_INIT(NodeMap::Init) {
  * over the internet
  * @param {Function} [options.cancel]
  * @param {number} options.ratio pixel ratio
+ * @param {string} [options.shaderCache] directory to store compiled shader programs in
  * @example
  * var map = new mbgl.Map({ request: function() {} });
  * map.load(require('./test/fixtures/style.json'));
@@ -127,6 +128,11 @@ NAN_METHOD(NodeMap::New) {
         return Nan::ThrowError("Options object 'ratio' property must be a number");
     }
 
+    if (Nan::Has(options, Nan::New("shaderCache").ToLocalChecked()).FromJust()
+     && !Nan::Get(options, Nan::New("shaderCache").ToLocalChecked()).ToLocalChecked()->IsString()) {
+        return Nan::ThrowError("Options object 'shaderCache' property must be a string");
+    }
+
     info.This()->SetInternalField(1, options);
 
     try {
@@ -461,6 +467,11 @@ NodeMap::NodeMap(v8::Local<v8::Object> options) :
     map(std::make_unique<mbgl::Map>(view, *this, mbgl::MapMode::Still)),
     async(new uv_async_t) {
 
+    Nan::HandleScope scope;
+    if (Nan::Has(options, Nan::New("shaderCache").ToLocalChecked()).FromJust()) {
+        map->setShaderCachePath(*Nan::Utf8String(Nan::Get(options, Nan::New("shaderCache").ToLocalChecked()).ToLocalChecked()));
+    }
+
     async->data = this;
     uv_async_init(uv_default_loop(), async, [](UV_ASYNC_PARAMS(h)) {
         reinterpret_cast<NodeMap *>(h->data)->renderFinished();
@@ -9,15 +9,15 @@ namespace mbgl {
 AnnotationTileFeature::AnnotationTileFeature(FeatureType type_, GeometryCollection geometries_,
                                  std::unordered_map<std::string, std::string> properties_)
     : type(type_),
-      properties(std::move(properties_)),
+      properties(properties_.begin(), properties_.end()),
       geometries(std::move(geometries_)) {}
 
-optional<Value> AnnotationTileFeature::getValue(const std::string& key) const {
+const Value* AnnotationTileFeature::findValue(const std::string& key) const {
     auto it = properties.find(key);
     if (it != properties.end()) {
-        return optional<Value>(it->second);
+        return &it->second;
     }
-    return optional<Value>();
+    return nullptr;
 }
 
 util::ptr<GeometryTileLayer> AnnotationTile::getLayer(const std::string& name) const {
@@ -15,11 +15,11 @@ public:
                           std::unordered_map<std::string, std::string> properties = {{}});
 
     FeatureType getType() const override { return type; }
-    optional<Value> getValue(const std::string&) const override;
+    const Value* findValue(const std::string&) const override;
     GeometryCollection getGeometries() const override { return geometries; }
 
     const FeatureType type;
-    const std::unordered_map<std::string, std::string> properties;
+    const std::unordered_map<std::string, Value> properties;
     const GeometryCollection geometries;
 };
 
@@ -3,10 +3,12 @@
 
 #include <mbgl/gl/gl.hpp>
 #include <mbgl/gl/gl_object_store.hpp>
+#include <mbgl/gl/buffer_arena.hpp>
 #include <mbgl/platform/log.hpp>
 #include <mbgl/util/noncopyable.hpp>
 #include <mbgl/util/thread_context.hpp>
 
+#include <algorithm>
 #include <memory>
 #include <cstdlib>
 #include <cassert>
@@ -24,6 +26,9 @@ class Buffer : private util::noncopyable {
 public:
     ~Buffer() {
         cleanup();
+        if (range) {
+            glObjectStore->getBufferArena().release(range);
+        }
     }
 
     // Returns the number of elements in this buffer. This is not the number of
@@ -36,18 +41,18 @@ public:
         return pos == 0;
     }
 
-    // Transfers this buffer to the GPU and binds the buffer to the GL context.
-    void bind(gl::GLObjectStore& glObjectStore) {
-        if (buffer) {
+    // Transfers this buffer to the GPU and binds the buffer to the GL context. The data is
+    // stored in a range of a buffer object that is shared with other buffers; see getOffset().
+    void bind(gl::GLObjectStore& glObjectStore_) {
+        if (range) {
             MBGL_CHECK_ERROR(glBindBuffer(bufferType, getID()));
         } else {
-            buffer.create(glObjectStore);
-            MBGL_CHECK_ERROR(glBindBuffer(bufferType, getID()));
             if (array == nullptr) {
                 Log::Debug(Event::OpenGL, "Buffer doesn't contain elements");
                 pos = 0;
             }
-            MBGL_CHECK_ERROR(glBufferData(bufferType, pos, array, GL_STATIC_DRAW));
+            glObjectStore = &glObjectStore_;
+            range = glObjectStore->getBufferArena().allocate(bufferType, pos, array, *glObjectStore);
             if (!retainAfterUpload) {
                 cleanup();
             }
@@ -62,24 +67,31 @@ public:
     }
 
     GLuint getID() const {
-        return buffer.getID();
+        return range.buffer;
+    }
+
+    // Byte offset of this buffer's data in the buffer object returned by getID(). Only valid
+    // once the buffer was bound.
+    GLsizeiptr getOffset() const {
+        return range.offset;
     }
 
     // Uploads the buffer to the GPU to be available when we need it.
-    inline void upload(gl::GLObjectStore& glObjectStore) {
-        if (!buffer) {
-            bind(glObjectStore);
+    inline void upload(gl::GLObjectStore& glObjectStore_) {
+        if (!range) {
+            bind(glObjectStore_);
         }
     }
 
 protected:
     // increase the buffer size by at least /required/ bytes.
     inline void *addElement() {
-        if (buffer) {
+        if (range) {
             throw std::runtime_error("Can't add elements after buffer was bound to GPU");
         }
         if (length < pos + itemSize) {
-            while (length < pos + itemSize) length += defaultLength;
+            // Grow geometrically so that building large buffers doesn't reallocate over and over.
+            while (length < pos + itemSize) length = std::max<size_t>(length * 2, defaultLength);
             array = realloc(array, length);
             if (array == nullptr) {
                 throw std::runtime_error("Buffer reallocation failed");
@@ -115,8 +127,9 @@ private:
     // Number of bytes that are valid in this buffer.
     size_t length = 0;
 
-    // GL buffer object handle.
-    gl::BufferHolder buffer;
+    // Range of a shared GL buffer object that holds the uploaded data.
+    gl::BufferArena::Range range;
+    gl::GLObjectStore* glObjectStore = nullptr;
 };
 
 } // namespace mbgl
@@ -2,15 +2,10 @@
 
 using namespace mbgl;
 
-void TriangleElementsBuffer::add(element_type a, element_type b, element_type c) {
-    element_type *elements = static_cast<element_type *>(addElement());
-    elements[0] = a;
-    elements[1] = b;
-    elements[2] = c;
-}
-
-void LineElementsBuffer::add(element_type a, element_type b) {
-    element_type *elements = static_cast<element_type *>(addElement());
-    elements[0] = a;
-    elements[1] = b;
+QuadElementsBuffer::QuadElementsBuffer() {
+    for (GLsizei i = 0; i < maxQuads; i++) {
+        const element_type vertex = i * 4;
+        add(vertex + 0, vertex + 1, vertex + 2);
+        add(vertex + 1, vertex + 2, vertex + 3);
+    }
 }
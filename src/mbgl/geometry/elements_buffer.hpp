@@ -23,25 +23,144 @@ struct ElementGroup : public util::noncopyable {
     }
 };
 
-class TriangleElementsBuffer : public Buffer<
-    6, // bytes per triangle (3 * unsigned short == 6 bytes)
+template <typename T>
+class TriangleElements : public Buffer<
+    3 * sizeof(T), // bytes per triangle
     GL_ELEMENT_ARRAY_BUFFER
 > {
+    template <typename> friend class TriangleElements;
+
 public:
-    typedef uint16_t element_type;
+    typedef T element_type;
+
+    void add(element_type a, element_type b, element_type c) {
+        element_type *elements = static_cast<element_type *>(this->addElement());
+        elements[0] = a;
+        elements[1] = b;
+        elements[2] = c;
+    }
 
-    void add(element_type a, element_type b, element_type c);
+    // Appends the triangles of another buffer, converting their indices to this buffer's type.
+    template <typename U>
+    void add(TriangleElements<U>& other) {
+        for (GLsizei i = 0; i < other.index(); i++) {
+            const U *elements = static_cast<const U *>(other.getElement(i));
+            add(elements[0], elements[1], elements[2]);
+        }
+    }
 };
 
+using TriangleElementsBuffer = TriangleElements<uint16_t>;
+using TriangleElementsBuffer32 = TriangleElements<uint32_t>;
+
+// Indices for a group of quads that each consist of four consecutive vertices, laid out as
+// {0, 1, 2}, {1, 2, 3}, {4, 5, 6}, {5, 6, 7}, ... Every bucket that only draws such quads
+// uses the same indices, so they share one instance instead of storing their own copy.
+class QuadElementsBuffer : public TriangleElementsBuffer {
+public:
+    // Enough quads to address every vertex of a group.
+    static const GLsizei maxQuads = 65536 / 4;
+
+    QuadElementsBuffer();
+};
 
-class LineElementsBuffer : public Buffer<
-    4, // bytes per triangle (2 * unsigned short == 6 bytes)
+template <typename T>
+class LineElements : public Buffer<
+    2 * sizeof(T), // bytes per line
     GL_ELEMENT_ARRAY_BUFFER
 > {
+    template <typename> friend class LineElements;
+
+public:
+    typedef T element_type;
+
+    void add(element_type a, element_type b) {
+        element_type *elements = static_cast<element_type *>(this->addElement());
+        elements[0] = a;
+        elements[1] = b;
+    }
+
+    // Appends the lines of another buffer, converting their indices to this buffer's type.
+    template <typename U>
+    void add(LineElements<U>& other) {
+        for (GLsizei i = 0; i < other.index(); i++) {
+            const U *elements = static_cast<const U *>(other.getElement(i));
+            add(elements[0], elements[1]);
+        }
+    }
+};
+
+using LineElementsBuffer = LineElements<uint16_t>;
+using LineElementsBuffer32 = LineElements<uint32_t>;
+
+// Elements of a bucket that may reference more vertices than 16 bit indices can address. The
+// indices start out as 16 bit indices. When the bucket outgrows them, expand() converts them to
+// 32 bit indices if the GL implementation supports those, so that the bucket can keep drawing
+// all of its vertices with a single element group, i.e. one VAO and one draw call. Otherwise,
+// the bucket has to start a new element group.
+template <template <typename> class Elements>
+class ExpandableElementsBuffer : private util::noncopyable {
 public:
-    typedef uint16_t element_type;
+    template <typename... Indices>
+    void add(Indices... indices) {
+        if (expanded) {
+            elements32.add(indices...);
+        } else {
+            elements16.add(static_cast<uint16_t>(indices)...);
+        }
+    }
+
+    // Returns false if the indices are limited to 16 bits.
+    bool expand() {
+        if (!expanded && gl::SupportsElementIndexUint()) {
+            elements32.add(elements16);
+            elements16.cleanup();
+            expanded = true;
+        }
+        return expanded;
+    }
+
+    // The index type to pass to glDrawElements().
+    GLenum type() const {
+        return expanded ? GL_UNSIGNED_INT : GL_UNSIGNED_SHORT;
+    }
+
+    size_t itemSize() const {
+        if (expanded) {
+            return Elements<uint32_t>::itemSize;
+        } else {
+            return Elements<uint16_t>::itemSize;
+        }
+    }
+
+    void upload(gl::GLObjectStore& glObjectStore) {
+        if (expanded) {
+            elements32.upload(glObjectStore);
+        } else {
+            elements16.upload(glObjectStore);
+        }
+    }
+
+    void bind(gl::GLObjectStore& glObjectStore) {
+        if (expanded) {
+            elements32.bind(glObjectStore);
+        } else {
+            elements16.bind(glObjectStore);
+        }
+    }
+
+    GLuint getID() const {
+        return expanded ? elements32.getID() : elements16.getID();
+    }
+
+    GLsizeiptr getOffset() const {
+        return expanded ? elements32.getOffset() : elements16.getOffset();
+    }
 
-    void add(element_type a, element_type b);
+private:
+    Elements<uint16_t> elements16;
+    Elements<uint32_t> elements32;
+    bool expanded = false;
 };
 
 } // namespace mbgl
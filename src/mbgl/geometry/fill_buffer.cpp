@@ -2,6 +2,7 @@
 
 #include <mbgl/gl/gl.hpp>
 
+#include <algorithm>
 #include <climits>
 
 using namespace mbgl;
@@ -11,3 +12,14 @@ void FillVertexBuffer::add(vertex_type x, vertex_type y) {
     vertices[0] = x;
     vertices[1] = y;
 }
+
+void FillColorVertexBuffer::add(vertex_type x, vertex_type y, const std::array<uint8_t, 4>& color) {
+    void *data = addElement();
+
+    vertex_type *vertices = static_cast<vertex_type *>(data);
+    vertices[0] = x;
+    vertices[1] = y;
+
+    uint8_t *colors = static_cast<uint8_t *>(data) + 4;
+    std::copy(color.begin(), color.end(), colors);
+}
@@ -2,6 +2,7 @@
 #define MBGL_GEOMETRY_FILL_BUFFER
 
 #include <mbgl/geometry/buffer.hpp>
+#include <array>
 #include <vector>
 #include <cstdint>
 
@@ -16,6 +17,17 @@ public:
     void add(vertex_type x, vertex_type y);
 };
 
+// Fill vertices with a color for each vertex, for fills whose color depends on a feature
+// property.
+class FillColorVertexBuffer : public Buffer<
+    8 // bytes per vertex (2 * short + 4 * unsigned byte == 8 bytes)
+> {
+public:
+    typedef int16_t vertex_type;
+
+    void add(vertex_type x, vertex_type y, const std::array<uint8_t, 4>& color);
+};
+
 } // namespace mbgl
 
 #endif
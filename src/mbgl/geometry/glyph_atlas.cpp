@@ -165,6 +165,7 @@ void GlyphAtlas::upload(gl::GLObjectStore& glObjectStore) {
                 GL_UNSIGNED_BYTE, // GLenum type
                 data.get() // const GLvoid* data
             ));
+            glObjectStore.counters.bytesUploaded += width * height;
         } else {
             MBGL_CHECK_ERROR(glTexSubImage2D(
                 GL_TEXTURE_2D, // GLenum target
@@ -177,6 +178,7 @@ void GlyphAtlas::upload(gl::GLObjectStore& glObjectStore) {
                 GL_UNSIGNED_BYTE, // GLenum type
                 data.get() // const GLvoid* data
             ));
+            glObjectStore.counters.bytesUploaded += width * height;
         }
 
         dirty = false;
@@ -191,6 +193,7 @@ void GlyphAtlas::bind(gl::GLObjectStore& glObjectStore) {
     if (!texture) {
         texture.create(glObjectStore);
         MBGL_CHECK_ERROR(glBindTexture(GL_TEXTURE_2D, texture.getID()));
+        glObjectStore.counters.textureBinds++;
 #ifndef GL_ES_VERSION_2_0
         MBGL_CHECK_ERROR(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0));
 #endif
@@ -200,5 +203,6 @@ void GlyphAtlas::bind(gl::GLObjectStore& glObjectStore) {
         MBGL_CHECK_ERROR(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE));
     } else {
         MBGL_CHECK_ERROR(glBindTexture(GL_TEXTURE_2D, texture.getID()));
+        glObjectStore.counters.textureBinds++;
     }
 };
@@ -138,6 +138,7 @@ void LineAtlas::bind(gl::GLObjectStore& glObjectStore) {
     if (!texture) {
         texture.create(glObjectStore);
         MBGL_CHECK_ERROR(glBindTexture(GL_TEXTURE_2D, texture.getID()));
+        glObjectStore.counters.textureBinds++;
         MBGL_CHECK_ERROR(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR));
         MBGL_CHECK_ERROR(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR));
         MBGL_CHECK_ERROR(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT));
@@ -145,6 +146,7 @@ void LineAtlas::bind(gl::GLObjectStore& glObjectStore) {
         first = true;
     } else {
         MBGL_CHECK_ERROR(glBindTexture(GL_TEXTURE_2D, texture.getID()));
+        glObjectStore.counters.textureBinds++;
     }
 
     if (dirty) {
@@ -160,6 +162,7 @@ void LineAtlas::bind(gl::GLObjectStore& glObjectStore) {
                 GL_UNSIGNED_BYTE, // GLenum type
                 data.get() // const GLvoid * data
             ));
+            glObjectStore.counters.bytesUploaded += width * height;
         } else {
             MBGL_CHECK_ERROR(glTexSubImage2D(
                 GL_TEXTURE_2D, // GLenum target
@@ -172,6 +175,7 @@ void LineAtlas::bind(gl::GLObjectStore& glObjectStore) {
                 GL_UNSIGNED_BYTE, // GLenum type
                 data.get() // const GLvoid *pixels
             ));
+            glObjectStore.counters.bytesUploaded += width * height;
         }
 
 
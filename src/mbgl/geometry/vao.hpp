@@ -24,7 +24,7 @@ public:
         bindVertexArrayObject(glObjectStore);
         if (bound_shader == 0) {
             vertexBuffer.bind(glObjectStore);
-            shader.bind(offset);
+            shader.bind(offset + vertexBuffer.getOffset());
             if (vao) {
                 storeBinding(shader, vertexBuffer.getID(), 0, offset);
             }
@@ -39,7 +39,7 @@ public:
         if (bound_shader == 0) {
             vertexBuffer.bind(glObjectStore);
             elementsBuffer.bind(glObjectStore);
-            shader.bind(offset);
+            shader.bind(offset + vertexBuffer.getOffset());
             if (vao) {
                 storeBinding(shader, vertexBuffer.getID(), elementsBuffer.getID(), offset);
             }
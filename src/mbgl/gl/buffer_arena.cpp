@@ -0,0 +1,125 @@
+#include <mbgl/gl/buffer_arena.hpp>
+
+#include <algorithm>
+#include <cassert>
+
+namespace mbgl {
+namespace gl {
+
+namespace {
+
+// Keeps every range suitably aligned for any vertex attribute or index type.
+const GLsizeiptr alignment = 16;
+
+GLsizeiptr alignedSize(GLsizeiptr size) {
+    // Empty buffers still get a range so that they have a buffer object to bind.
+    return std::max<GLsizeiptr>(alignment, (size + alignment - 1) / alignment * alignment);
+}
+
+} // namespace
+
+const GLsizeiptr BufferArena::PageSize;
+const size_t BufferArena::MaxEmptyPages;
+
+BufferArena::Range BufferArena::allocate(GLenum target, GLsizeiptr size, const GLvoid* data, GLObjectStore& glObjectStore) {
+    const GLsizeiptr blockSize = alignedSize(size);
+
+    Page* page = nullptr;
+    auto block = std::map<GLsizeiptr, GLsizeiptr>::iterator();
+
+    // First fit.
+    for (auto& candidate : pages) {
+        if (candidate->target != target || candidate->size - candidate->used < blockSize) {
+            continue;
+        }
+        block = std::find_if(candidate->freeBlocks.begin(), candidate->freeBlocks.end(),
+            [&] (const std::pair<const GLsizeiptr, GLsizeiptr>& free) { return free.second >= blockSize; });
+        if (block != candidate->freeBlocks.end()) {
+            page = candidate.get();
+            break;
+        }
+    }
+
+    if (!page) {
+        // Data that is larger than a page gets a page of its own.
+        auto newPage = std::make_unique<Page>();
+        newPage->target = target;
+        newPage->size = std::max(PageSize, blockSize);
+        newPage->buffer.create(glObjectStore);
+        MBGL_CHECK_ERROR(glBindBuffer(target, newPage->buffer.getID()));
+        MBGL_CHECK_ERROR(glBufferData(target, newPage->size, nullptr, GL_STATIC_DRAW));
+        block = newPage->freeBlocks.emplace(0, newPage->size).first;
+        page = newPage.get();
+        pages.push_back(std::move(newPage));
+    } else {
+        MBGL_CHECK_ERROR(glBindBuffer(target, page->buffer.getID()));
+    }
+
+    Range range;
+    range.target = target;
+    range.buffer = page->buffer.getID();
+    range.offset = block->first;
+    range.size = blockSize;
+
+    if (block->second > blockSize) {
+        page->freeBlocks.emplace(block->first + blockSize, block->second - blockSize);
+    }
+    page->freeBlocks.erase(block);
+    page->used += blockSize;
+
+    if (size > 0 && data) {
+        MBGL_CHECK_ERROR(glBufferSubData(target, range.offset, size, data));
+        glObjectStore.counters.bytesUploaded += size;
+    }
+
+    return range;
+}
+
+void BufferArena::release(const Range& range) {
+    auto it = std::find_if(pages.begin(), pages.end(), [&] (const std::unique_ptr<Page>& page) {
+        return page->buffer.getID() == range.buffer;
+    });
+    assert(it != pages.end());
+    if (it == pages.end()) {
+        return;
+    }
+
+    Page& page = **it;
+    page.used -= range.size;
+
+    // Return the block and merge it with adjacent free blocks.
+    auto block = page.freeBlocks.emplace(range.offset, range.size).first;
+    auto next = std::next(block);
+    if (next != page.freeBlocks.end() && block->first + block->second == next->first) {
+        block->second += next->second;
+        page.freeBlocks.erase(next);
+    }
+    if (block != page.freeBlocks.begin()) {
+        auto prev = std::prev(block);
+        if (prev->first + prev->second == block->first) {
+            prev->second += block->second;
+            page.freeBlocks.erase(block);
+        }
+    }
+
+    if (page.used > 0) {
+        return;
+    }
+
+    // Keep a few empty pages of the regular size around for reuse and abandon the rest.
+    const size_t emptyPages = std::count_if(pages.begin(), pages.end(), [&] (const std::unique_ptr<Page>& other) {
+        return other->target == page.target && other->used == 0 && other->size == PageSize;
+    });
+    if (page.size != PageSize || emptyPages > MaxEmptyPages) {
+        pages.erase(it);
+    }
+}
+
+bool BufferArena::empty() const {
+    return std::all_of(pages.begin(), pages.end(), [] (const std::unique_ptr<Page>& page) {
+        return page->used == 0;
+    });
+}
+
+} // namespace gl
+} // namespace mbgl
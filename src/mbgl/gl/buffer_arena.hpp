@@ -0,0 +1,61 @@
+#ifndef MBGL_GL_BUFFER_ARENA
+#define MBGL_GL_BUFFER_ARENA
+
+#include <mbgl/gl/gl.hpp>
+#include <mbgl/gl/gl_object_store.hpp>
+#include <mbgl/util/noncopyable.hpp>
+
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace mbgl {
+namespace gl {
+
+// Suballocates vertex and index data from a small number of large GL buffer objects ("pages")
+// instead of creating one buffer object per Buffer. Pages that no longer hold any data are kept
+// around for reuse, up to a limit.
+class BufferArena : private util::noncopyable {
+public:
+    static const GLsizeiptr PageSize = 1024 * 1024;
+    static const size_t MaxEmptyPages = 2;
+
+    struct Range {
+        GLenum target = 0;
+        GLuint buffer = 0;
+        GLsizeiptr offset = 0;
+        GLsizeiptr size = 0;
+
+        explicit operator bool() const { return buffer; }
+    };
+
+    // Copies the data into a free range of a page for the given target. The page is left bound
+    // to the target.
+    Range allocate(GLenum target, GLsizeiptr size, const GLvoid* data, GLObjectStore&);
+
+    // Returns the range to its page. This doesn't make any GL calls and is safe to call
+    // while the context isn't current; pages beyond the reuse limit are abandoned to the
+    // GLObjectStore.
+    void release(const Range&);
+
+    // True when no range is allocated.
+    bool empty() const;
+
+private:
+    struct Page {
+        GLenum target;
+        GLsizeiptr size;
+        GLsizeiptr used = 0;
+        BufferHolder buffer;
+
+        // Maps the offset of each free block to its size.
+        std::map<GLsizeiptr, GLsizeiptr> freeBlocks;
+    };
+
+    std::vector<std::unique_ptr<Page>> pages;
+};
+
+} // namespace gl
+} // namespace mbgl
+
+#endif
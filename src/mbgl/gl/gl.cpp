@@ -2,6 +2,7 @@
 #include <mbgl/util/string.hpp>
 #include <mbgl/platform/log.hpp>
 
+#include <atomic>
 #include <cassert>
 #include <iostream>
 #include <map>
@@ -17,6 +18,12 @@ std::vector<ExtensionFunctionBase*>& ExtensionFunctionBase::functions() {
 
 static std::once_flag initializeExtensionsOnce;
 
+#ifdef GL_ES_VERSION_2_0
+static std::atomic<bool> elementIndexUint { false };
+#else
+static std::atomic<bool> elementIndexUint { true };
+#endif
+
 void InitializeExtensions(glProc (*getProcAddress)(const char *)) {
     std::call_once(initializeExtensionsOnce, [getProcAddress] {
         const char * extensionsPtr = reinterpret_cast<const char *>(
@@ -26,6 +33,10 @@ void InitializeExtensions(glProc (*getProcAddress)(const char *)) {
             return;
 
         const std::string extensions = extensionsPtr;
+#ifdef GL_ES_VERSION_2_0
+        elementIndexUint = extensions.find("GL_OES_element_index_uint") != std::string::npos;
+#endif
+
         for (auto fn : ExtensionFunctionBase::functions()) {
             for (auto probe : fn->probes) {
                 if (extensions.find(probe.first) != std::string::npos) {
@@ -40,6 +51,10 @@ void InitializeExtensions(glProc (*getProcAddress)(const char *)) {
     });
 }
 
+bool SupportsElementIndexUint() {
+    return elementIndexUint;
+}
+
 void checkError(const char *cmd, const char *file, int line) {
     const GLenum err = glGetError();
     if (err != GL_NO_ERROR) {
@@ -18,6 +18,7 @@ public:
             dirty = false;
             current = value;
             T::Set(current);
+            ++changes;
         }
     }
 
@@ -25,15 +26,28 @@ public:
         dirty = true;
         current = T::Default;
         T::Set(current);
+        ++changes;
+    }
+
+    // Like reset(), but skips the GL call if the default is known to be set already. Use this
+    // when restoring state for every draw call.
+    inline void setDefault() {
+        operator=(T::Default);
     }
 
     inline void setDirty() {
         dirty = true;
     }
 
+    // Number of times this value was actually set on the GL context.
+    inline uint32_t getChanges() const {
+        return changes;
+    }
+
 private:
     typename T::Type current = T::Default;
     bool dirty = false;
+    uint32_t changes = 0;
 };
 
 class Config {
@@ -76,6 +90,15 @@ public:
         lineWidth.setDirty();
     }
 
+    // Number of state changes issued, not counting program switches.
+    uint32_t getStateChanges() const {
+        return stencilFunc.getChanges() + stencilMask.getChanges() + stencilTest.getChanges() +
+            stencilOp.getChanges() + depthRange.getChanges() + depthMask.getChanges() +
+            depthTest.getChanges() + depthFunc.getChanges() + blend.getChanges() +
+            blendFunc.getChanges() + colorMask.getChanges() + clearDepth.getChanges() +
+            clearColor.getChanges() + clearStencil.getChanges() + lineWidth.getChanges();
+    }
+
     Value<StencilFunc> stencilFunc;
     Value<StencilMask> stencilMask;
     Value<StencilTest> stencilTest;
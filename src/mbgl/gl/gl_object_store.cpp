@@ -1,4 +1,6 @@
 #include <mbgl/gl/gl_object_store.hpp>
+#include <mbgl/gl/buffer_arena.hpp>
+#include <mbgl/gl/program_cache.hpp>
 
 #include <cassert>
 
@@ -81,7 +83,10 @@ void VAOHolder::reset() {
     id = 0;
 }
 
+GLObjectStore::GLObjectStore() = default;
+
 GLObjectStore::~GLObjectStore() {
+    assert(!bufferArena);
     assert(abandonedPrograms.empty());
     assert(abandonedShaders.empty());
     assert(abandonedBuffers.empty());
@@ -89,7 +94,36 @@ GLObjectStore::~GLObjectStore() {
     assert(abandonedVAOs.empty());
 }
 
+BufferArena& GLObjectStore::getBufferArena() {
+    if (!bufferArena) {
+        bufferArena = std::make_unique<BufferArena>();
+    }
+    return *bufferArena;
+}
+
+void GLObjectStore::setProgramCachePath(const std::string& path) {
+    programCachePath = path;
+    programCache.reset();
+    programCacheChecked = false;
+}
+
+ProgramCache* GLObjectStore::getProgramCache() {
+    if (!programCacheChecked) {
+        programCacheChecked = true;
+        if (!programCachePath.empty() && ProgramCache::isSupported()) {
+            programCache = std::make_unique<ProgramCache>(programCachePath);
+        }
+    }
+    return programCache.get();
+}
+
 void GLObjectStore::performCleanup() {
+    // Once nothing is allocated from the arena anymore, e.g. on teardown, drop it along with
+    // the pages it keeps for reuse.
+    if (bufferArena && bufferArena->empty()) {
+        bufferArena.reset();
+    }
+
     for (GLuint id : abandonedPrograms) {
         MBGL_CHECK_ERROR(glDeleteProgram(id));
     }
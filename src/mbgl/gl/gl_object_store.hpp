@@ -2,24 +2,44 @@
 #define MBGL_MAP_UTIL_GL_OBJECT_STORE
 
 #include <mbgl/gl/gl.hpp>
+#include <mbgl/map/render_statistics.hpp>
 #include <mbgl/util/noncopyable.hpp>
 
 #include <array>
 #include <algorithm>
 #include <memory>
+#include <string>
 #include <vector>
 
 namespace mbgl {
 namespace gl {
 
+class BufferArena;
+class ProgramCache;
+
 class GLObjectStore : private util::noncopyable {
 public:
+    GLObjectStore();
     ~GLObjectStore();
 
+    // Shared buffer objects that vertex and index buffers are suballocated from.
+    BufferArena& getBufferArena();
+
+    // Directory that linked program binaries are stored in. Empty disables storing them.
+    void setProgramCachePath(const std::string&);
+
+    // Returns nullptr if no cache path is set or the context can't retrieve program binaries.
+    ProgramCache* getProgramCache();
+
     // Actually remove the objects we marked as abandoned with the above methods.
     // Only call this while the OpenGL context is exclusive to this thread.
     void performCleanup();
 
+    // Running totals of the work issued through this context. Draw calls, texture binds,
+    // uniform uploads and uploaded bytes are counted here; Painter adds the state changes
+    // tracked by gl::Config and turns the totals into per-frame statistics.
+    RenderCounters counters;
+
 private:
     friend class ProgramHolder;
     friend class ShaderHolder;
@@ -33,6 +53,12 @@ private:
     std::vector<GLuint> abandonedBuffers;
     std::vector<GLuint> abandonedTextures;
     std::vector<GLuint> abandonedVAOs;
+
+    std::unique_ptr<BufferArena> bufferArena;
+
+    std::string programCachePath;
+    std::unique_ptr<ProgramCache> programCache;
+    bool programCacheChecked = false;
 };
 
 class GLHolder : private util::noncopyable {
@@ -0,0 +1,163 @@
+#include <mbgl/gl/program_cache.hpp>
+#include <mbgl/platform/log.hpp>
+#include <mbgl/util/io.hpp>
+#include <mbgl/util/string.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+#ifndef GL_PROGRAM_BINARY_RETRIEVABLE_HINT
+#define GL_PROGRAM_BINARY_RETRIEVABLE_HINT 0x8257
+#endif
+
+#ifndef GL_PROGRAM_BINARY_LENGTH
+#define GL_PROGRAM_BINARY_LENGTH 0x8741
+#endif
+
+#ifndef GL_NUM_PROGRAM_BINARY_FORMATS
+#define GL_NUM_PROGRAM_BINARY_FORMATS 0x87FE
+#endif
+
+#ifndef GL_PROGRAM_BINARY_FORMATS
+#define GL_PROGRAM_BINARY_FORMATS 0x87FF
+#endif
+
+namespace mbgl {
+namespace gl {
+
+static ExtensionFunction<
+    void (GLuint program,
+          GLsizei bufSize,
+          GLsizei* length,
+          GLenum* binaryFormat,
+          GLvoid* binary)>
+    GetProgramBinary({
+        {"GL_ARB_get_program_binary", "glGetProgramBinary"},
+        {"GL_OES_get_program_binary", "glGetProgramBinaryOES"}
+    });
+
+static ExtensionFunction<
+    void (GLuint program,
+          GLenum binaryFormat,
+          const GLvoid* binary,
+          GLint length)>
+    ProgramBinary({
+        {"GL_ARB_get_program_binary", "glProgramBinary"},
+        {"GL_OES_get_program_binary", "glProgramBinaryOES"}
+    });
+
+static ExtensionFunction<
+    void (GLuint program,
+          GLenum pname,
+          GLint value)>
+    ProgramParameteri({
+        {"GL_ARB_get_program_binary", "glProgramParameteri"}
+    });
+
+static std::vector<GLint> supportedFormats() {
+    GLint count = 0;
+    MBGL_CHECK_ERROR(glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &count));
+    std::vector<GLint> formats(count);
+    if (count > 0) {
+        MBGL_CHECK_ERROR(glGetIntegerv(GL_PROGRAM_BINARY_FORMATS, formats.data()));
+    }
+    return formats;
+}
+
+ProgramCache::ProgramCache(const std::string& path_) : path(path_) {
+}
+
+bool ProgramCache::isSupported() {
+    // Some drivers expose the extension but don't support any binary formats.
+    return GetProgramBinary && ProgramBinary && !supportedFormats().empty();
+}
+
+std::string ProgramCache::filename(const char* name, const GLchar* vertex, const GLchar* fragment) {
+    if (driver.empty()) {
+        for (GLenum key : { GL_VENDOR, GL_RENDERER, GL_VERSION }) {
+            const GLubyte* value = MBGL_CHECK_ERROR(glGetString(key));
+            if (value) {
+                driver += reinterpret_cast<const char*>(value);
+            }
+            driver += '\n';
+        }
+    }
+
+    const size_t hash = std::hash<std::string>()(driver + vertex + '\n' + fragment);
+    return path + "/" + name + "-" + util::toString(hash) + ".bin";
+}
+
+bool ProgramCache::load(GLuint program, const char* name, const GLchar* vertex, const GLchar* fragment) {
+    std::string data;
+    try {
+        data = util::read_file(filename(name, vertex, fragment));
+    } catch (const std::exception&) {
+        return false;
+    }
+
+    GLenum format;
+    if (data.size() <= sizeof(format)) {
+        return false;
+    }
+    std::memcpy(&format, data.data(), sizeof(format));
+
+    // Loading a binary in a format that isn't supported (anymore) is an error, not just a failure to link.
+    const std::vector<GLint> formats = supportedFormats();
+    if (std::find(formats.begin(), formats.end(), static_cast<GLint>(format)) == formats.end()) {
+        return false;
+    }
+
+    MBGL_CHECK_ERROR(ProgramBinary(program, format, data.data() + sizeof(format),
+                                   static_cast<GLint>(data.size() - sizeof(format))));
+
+    // The driver may still reject the binary, e.g. after it was updated.
+    GLint status = 0;
+    MBGL_CHECK_ERROR(glGetProgramiv(program, GL_LINK_STATUS, &status));
+    return status != 0;
+}
+
+void ProgramCache::prepare(GLuint program) {
+    if (ProgramParameteri) {
+        MBGL_CHECK_ERROR(ProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE));
+    }
+}
+
+void ProgramCache::save(GLuint program, const char* name, const GLchar* vertex, const GLchar* fragment) {
+    GLint length = 0;
+    MBGL_CHECK_ERROR(glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length));
+    if (length <= 0) {
+        return;
+    }
+
+    GLenum format = 0;
+    std::string data(sizeof(format) + length, '\0');
+    MBGL_CHECK_ERROR(GetProgramBinary(program, length, &length, &format, &data[sizeof(format)]));
+    std::memcpy(&data[0], &format, sizeof(format));
+    data.resize(sizeof(format) + length);
+
+    // Several processes may share the directory, so never let them read a partially written
+    // binary: write it to a file of our own and rename it, which replaces the file atomically.
+    const std::string target = filename(name, vertex, fragment);
+    const std::string temporary = target + "." + util::toString(getpid()) + "-" +
+        util::toString(std::hash<std::thread::id>()(std::this_thread::get_id())) + ".tmp";
+
+    try {
+        util::write_file(temporary, data);
+        if (std::rename(temporary.c_str(), target.c_str()) != 0) {
+            throw std::runtime_error(std::string("Failed to rename file ") + temporary);
+        }
+    } catch (const std::exception& e) {
+        std::remove(temporary.c_str());
+        Log::Warning(Event::Shader, "Failed to store program binary for %s: %s", name, e.what());
+    }
+}
+
+} // namespace gl
+} // namespace mbgl
@@ -0,0 +1,42 @@
+#ifndef MBGL_GL_PROGRAM_CACHE
+#define MBGL_GL_PROGRAM_CACHE
+
+#include <mbgl/gl/gl.hpp>
+#include <mbgl/util/noncopyable.hpp>
+
+#include <string>
+
+namespace mbgl {
+namespace gl {
+
+// Stores linked program binaries in a directory so that programs don't need to be compiled
+// from source again when another map is created. Binaries only work with the driver that
+// produced them, so the file names include a hash of the GL vendor, renderer and version
+// strings as well as of the shader sources.
+class ProgramCache : private util::noncopyable {
+public:
+    explicit ProgramCache(const std::string& path);
+
+    // Whether the current context can retrieve and load program binaries.
+    static bool isSupported();
+
+    // Links the program from a cached binary. Returns false if there is no usable binary,
+    // in which case the program needs to be compiled and linked from source.
+    bool load(GLuint program, const char* name, const GLchar* vertex, const GLchar* fragment);
+
+    // Marks the program as retrievable. Call this before linking a program that is saved later.
+    void prepare(GLuint program);
+
+    void save(GLuint program, const char* name, const GLchar* vertex, const GLchar* fragment);
+
+private:
+    std::string filename(const char* name, const GLchar* vertex, const GLchar* fragment);
+
+    const std::string path;
+    std::string driver;
+};
+
+} // namespace gl
+} // namespace mbgl
+
+#endif
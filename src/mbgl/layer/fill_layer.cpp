@@ -1,7 +1,11 @@
 #include <mbgl/layer/fill_layer.hpp>
 #include <mbgl/style/style_bucket_parameters.hpp>
+#include <mbgl/style/property_parsing.hpp>
 #include <mbgl/renderer/fill_bucket.hpp>
 #include <mbgl/util/get_geometries.hpp>
+#include <mbgl/platform/log.hpp>
+
+#include <algorithm>
 
 namespace mbgl {
 
@@ -17,6 +21,22 @@ void FillLayer::parsePaints(const JSValue& layer) {
     paint.translate.parse("fill-translate", layer);
     paint.translateAnchor.parse("fill-translate-anchor", layer);
     paint.pattern.parse("fill-pattern", layer);
+
+    paint.featureColor = {};
+    for (auto it = layer.MemberBegin(); it != layer.MemberEnd(); ++it) {
+        const std::string paintName { it->name.GetString(), it->name.GetStringLength() };
+        if (paintName.compare(0, 5, "paint") != 0 || !it->value.IsObject() || !it->value.HasMember("fill-color")) {
+            continue;
+        }
+
+        const JSValue& value = it->value["fill-color"];
+        if (paintName == "paint") {
+            paint.featureColor = parseProperty<PropertyFunction<Color>>("fill-color", value);
+        } else if (value.IsObject() && value.HasMember("property")) {
+            // The colors are baked into the buckets, which don't change with the classes.
+            Log::Warning(Event::ParseStyle, "'fill-color' property functions are only supported in the default paint class; ignoring the one in '%s'", paintName.c_str());
+        }
+    }
 }
 
 void FillLayer::cascade(const StyleCascadeParameters& parameters) {
@@ -46,7 +66,16 @@ bool FillLayer::recalculate(const StyleCalculationParameters& parameters) {
         passes |= RenderPass::Translucent;
     }
 
-    if (!paint.pattern.value.from.empty() || (paint.color.value[3] * paint.opacity) < 1.0f) {
+    float alpha = paint.color.value[3];
+    if (paint.featureColor) {
+        // The bucket is drawn in a single pass, so it is translucent if any feature is.
+        alpha = paint.featureColor->getDefault()[3];
+        for (const auto& stop : paint.featureColor->getStops()) {
+            alpha = std::min(alpha, stop.second[3]);
+        }
+    }
+
+    if (!paint.pattern.value.from.empty() || (alpha * paint.opacity) < 1.0f) {
         passes |= RenderPass::Translucent;
     } else {
         passes |= RenderPass::Opaque;
@@ -58,8 +87,16 @@ bool FillLayer::recalculate(const StyleCalculationParameters& parameters) {
 std::unique_ptr<Bucket> FillLayer::createBucket(StyleBucketParameters& parameters) const {
     auto bucket = std::make_unique<FillBucket>();
 
+    // This only depends on the parsed style: the pattern may change with the zoom level and
+    // classes, and the painter draws patterns from either layout.
+    const bool featureColors = bool(paint.featureColor);
+
     parameters.eachFilteredFeature(filter, [&] (const auto& feature) {
-        bucket->addGeometry(getGeometries(feature));
+        if (featureColors) {
+            bucket->addGeometry(getGeometries(feature), paint.featureColor->evaluate(feature));
+        } else {
+            bucket->addGeometry(getGeometries(feature));
+        }
     });
 
     return std::move(bucket);
@@ -3,6 +3,7 @@
 
 #include <mbgl/style/style_layer.hpp>
 #include <mbgl/style/paint_property.hpp>
+#include <mbgl/style/property_function.hpp>
 
 namespace mbgl {
 
@@ -15,6 +16,11 @@ public:
     PaintProperty<std::array<float, 2>> translate { {{ 0, 0 }} };
     PaintProperty<TranslateAnchorType> translateAnchor { TranslateAnchorType::Map };
     PaintProperty<std::string, Faded<std::string>> pattern { "" };
+
+    // Set when fill-color depends on a feature property. The color is then stored in the
+    // vertices of the bucket, and color only applies to the outline. Only the default paint
+    // class can set it: classes change at runtime, while the buckets are built once.
+    optional<PropertyFunction<Color>> featureColor;
 };
 
 class FillLayer : public StyleLayer {
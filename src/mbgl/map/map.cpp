@@ -540,6 +540,10 @@ std::vector<std::string> Map::getClasses() const {
     return context->invokeSync<std::vector<std::string>>(&MapContext::getClasses);
 }
 
+void Map::setShaderCachePath(const std::string& path) {
+    context->invoke(&MapContext::setShaderCachePath, path);
+}
+
 void Map::setSourceTileCacheSize(size_t size) {
     context->invoke(&MapContext::setSourceTileCacheSize, size);
 }
@@ -552,4 +556,12 @@ void Map::dumpDebugLogs() const {
     context->invokeSync(&MapContext::dumpDebugLogs);
 }
 
+void Map::setFrameProfileCallback(FrameProfileCallback callback) {
+    context->invoke(&MapContext::setFrameProfileCallback, callback);
+}
+
+RenderStatistics Map::getRenderStatistics() const {
+    return context->invokeSync<RenderStatistics>(&MapContext::getRenderStatistics);
+}
+
 } // namespace mbgl
@@ -168,21 +168,30 @@ void MapContext::update() {
     // - Calculate style property transitions;
     // - Hint style sources to notify when all its tiles are loaded;
     frameData.timePoint = Clock::now();
+    const TimePoint updateStart = frameData.timePoint;
 
     if (style->loaded && updateFlags & Update::Annotations) {
         data.getAnnotationManager()->updateStyle(*style);
         updateFlags |= Update::Classes;
     }
 
+    TimePoint phaseStart = Clock::now();
     if (updateFlags & Update::Classes) {
         style->cascade(frameData.timePoint);
     }
+    profile.cascade += Clock::now() - phaseStart;
 
+    phaseStart = Clock::now();
     if (updateFlags & Update::Classes || updateFlags & Update::RecalculateStyle) {
         style->recalculate(transformState.getZoom(), frameData.timePoint);
     }
+    profile.recalculate += Clock::now() - phaseStart;
 
+    phaseStart = Clock::now();
     style->update(transformState, frameData.timePoint, *texturePool);
+    profile.sourceUpdate += Clock::now() - phaseStart;
+
+    profile.total += Clock::now() - updateStart;
 
     if (data.mode == MapMode::Continuous) {
         asyncInvalidate.send();
@@ -234,13 +243,15 @@ bool MapContext::renderSync(const TransformState& state, const FrameData& frame)
         return false;
     }
 
+    const TimePoint renderStart = Clock::now();
+
     view.beforeRender();
 
     transformState = state;
     frameData = frame;
 
     if (!painter) painter = std::make_unique<Painter>(data, transformState, glObjectStore);
-    painter->render(*style, frame, data.getAnnotationManager()->getSpriteAtlas());
+    painter->render(*style, frame, data.getAnnotationManager()->getSpriteAtlas(), profile);
 
     if (data.mode == MapMode::Still) {
         callback(nullptr, view.readStillImage());
@@ -252,6 +263,13 @@ bool MapContext::renderSync(const TransformState& state, const FrameData& frame)
 
     view.afterRender();
 
+    profile.total += Clock::now() - renderStart;
+    if (profileCallback) {
+        style->profile(profile);
+        profileCallback(profile);
+    }
+    profile = {};
+
     if (style->hasTransitions()) {
         updateAsync(Update::RecalculateStyle);
     } else if (painter->needsAnimation()) {
@@ -311,6 +329,11 @@ void MapContext::setClasses(const std::vector<std::string>& classNames, const Pr
     updateAsync(Update::Classes);
 }
 
+void MapContext::setShaderCachePath(const std::string& path) {
+    assert(util::ThreadContext::currentlyOn(util::ThreadType::Map));
+    glObjectStore.setProgramCachePath(path);
+}
+
 void MapContext::setSourceTileCacheSize(size_t size) {
     assert(util::ThreadContext::currentlyOn(util::ThreadType::Map));
     if (size != sourceCacheSize) {
@@ -350,4 +373,12 @@ void MapContext::dumpDebugLogs() const {
     Log::Info(Event::General, "--------------------------------------------------------------------------------");
 }
 
+void MapContext::setFrameProfileCallback(Map::FrameProfileCallback callback_) {
+    profileCallback = callback_;
+}
+
+RenderStatistics MapContext::getRenderStatistics() const {
+    return painter ? painter->getStatistics() : RenderStatistics();
+}
+
 } // namespace mbgl
@@ -69,11 +69,14 @@ public:
     void setClasses(const std::vector<std::string>&, const PropertyTransition&);
     std::vector<std::string> getClasses() const;
 
+    void setShaderCachePath(const std::string&);
     void setSourceTileCacheSize(size_t size);
     void onLowMemory();
 
     void cleanup();
     void dumpDebugLogs() const;
+    RenderStatistics getRenderStatistics() const;
+    void setFrameProfileCallback(Map::FrameProfileCallback);
 
 private:
     void onResourceLoaded() override;
@@ -109,6 +112,9 @@ private:
     std::unique_ptr<AsyncRequest> styleRequest;
 
     Map::StillImageCallback callback;
+    Map::FrameProfileCallback profileCallback;
+    // Collects the timings of style updates and rendering until the frame is delivered.
+    FrameProfile profile;
     size_t sourceCacheSize;
     TransformState transformState;
     FrameData frameData;
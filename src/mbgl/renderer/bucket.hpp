@@ -38,6 +38,12 @@ public:
 
     virtual bool hasData() const = 0;
 
+    // Whether the geometry of this bucket covers the entire tile. When such a bucket is drawn
+    // opaquely, the layers below it in the same tile are hidden and don't need to be drawn.
+    virtual bool coversTile() const {
+        return false;
+    }
+
     inline bool needsUpload() const {
         return !uploaded;
     }
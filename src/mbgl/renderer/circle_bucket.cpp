@@ -84,7 +84,8 @@ void CircleBucket::drawCircles(CircleShader& shader, gl::GLObjectStore& glObject
 
         group->array[0].bind(shader, vertexBuffer_, elementsBuffer_, vertexIndex, glObjectStore);
 
-        MBGL_CHECK_ERROR(glDrawElements(GL_TRIANGLES, group->elements_length * 3, GL_UNSIGNED_SHORT, elementsIndex));
+        MBGL_CHECK_ERROR(glDrawElements(GL_TRIANGLES, group->elements_length * 3, GL_UNSIGNED_SHORT, elementsIndex + elementsBuffer_.getOffset()));
+        glObjectStore.counters.drawCalls++;
 
         vertexIndex += group->vertex_length * vertexBuffer_.itemSize;
         elementsIndex += group->elements_length * elementsBuffer_.itemSize;
@@ -33,9 +33,11 @@ DebugBucket::DebugBucket(const TileID id, const TileData::State state_, optional
 void DebugBucket::drawLines(PlainShader& shader, gl::GLObjectStore& glObjectStore) {
     array.bind(shader, fontBuffer, BUFFER_OFFSET_0, glObjectStore);
     MBGL_CHECK_ERROR(glDrawArrays(GL_LINES, 0, (GLsizei)(fontBuffer.index())));
+    glObjectStore.counters.drawCalls++;
 }
 
 void DebugBucket::drawPoints(PlainShader& shader, gl::GLObjectStore& glObjectStore) {
     array.bind(shader, fontBuffer, BUFFER_OFFSET_0, glObjectStore);
     MBGL_CHECK_ERROR(glDrawArrays(GL_POINTS, 0, (GLsizei)(fontBuffer.index())));
+    glObjectStore.counters.drawCalls++;
 }
@@ -6,10 +6,14 @@
 #include <mbgl/shader/plain_shader.hpp>
 #include <mbgl/shader/pattern_shader.hpp>
 #include <mbgl/shader/outline_shader.hpp>
+#include <mbgl/shader/fillcolor_shader.hpp>
 #include <mbgl/gl/gl.hpp>
 #include <mbgl/platform/log.hpp>
+#include <mbgl/util/constants.hpp>
+#include <mbgl/util/math.hpp>
 
 #include <cassert>
+#include <cmath>
 
 struct geometry_too_long_exception : std::exception {};
 
@@ -68,12 +72,31 @@ void FillBucket::addGeometry(const GeometryCollection& geometryCollection) {
     tessellate();
 }
 
+void FillBucket::addGeometry(const GeometryCollection& geometryCollection, const Color& color) {
+    assert(featureColors || vertexBuffer.empty());
+    featureColors = true;
+    for (size_t i = 0; i < 4; i++) {
+        vertexColor[i] = static_cast<uint8_t>(::round(util::clamp(color[i], 0.0f, 1.0f) * 255));
+    }
+
+    addGeometry(geometryCollection);
+}
+
+void FillBucket::addVertex(FillVertexBuffer::vertex_type x, FillVertexBuffer::vertex_type y) {
+    if (featureColors) {
+        colorVertexBuffer.add(x, y, vertexColor);
+    } else {
+        vertexBuffer.add(x, y);
+    }
+}
+
 void FillBucket::tessellate() {
     if (!hasVertices) {
         return;
     }
     hasVertices = false;
 
+    const ClipperLib::IntRect bounds = clipper.GetBounds();
     std::vector<std::vector<ClipperLib::IntPoint>> polygons;
     clipper.Execute(ClipperLib::ctUnion, polygons, ClipperLib::pftEvenOdd, ClipperLib::pftEvenOdd);
     clipper.Clear();
@@ -87,11 +110,27 @@ void FillBucket::tessellate() {
         total_vertex_count += polygon.size();
     }
 
-    if (total_vertex_count > 65536) {
+    // Only polygons that extend beyond all four tile edges can cover the tile, e.g. water or
+    // landuse at high zoom levels. They may still have holes, so check what's left of the tile.
+    if (!tileCovered && bounds.left <= 0 && bounds.top <= 0 &&
+        bounds.right >= util::EXTENT && bounds.bottom >= util::EXTENT) {
+        const ClipperLib::Path tile {
+            { 0, 0 }, { util::EXTENT, 0 }, { util::EXTENT, util::EXTENT }, { 0, util::EXTENT }
+        };
+        ClipperLib::Clipper difference;
+        difference.AddPath(tile, ClipperLib::ptSubject, true);
+        difference.AddPaths(polygons, ClipperLib::ptClip, true);
+        ClipperLib::Paths uncovered;
+        difference.Execute(ClipperLib::ctDifference, uncovered, ClipperLib::pftNonZero, ClipperLib::pftEvenOdd);
+        tileCovered = uncovered.empty();
+    }
+
+    if (total_vertex_count > 65536 && !lineElementsBuffer.expand()) {
         throw geometry_too_long_exception();
     }
 
-    if (lineGroups.empty() || (lineGroups.back()->vertex_length + total_vertex_count > 65535)) {
+    if (lineGroups.empty() ||
+        (lineGroups.back()->vertex_length + total_vertex_count > 65535 && !lineElementsBuffer.expand())) {
         // Move to a new group because the old one can't hold the geometry.
         lineGroups.emplace_back(std::make_unique<LineGroup>());
     }
@@ -108,7 +147,7 @@ void FillBucket::tessellate() {
         for (const auto& pt : polygon) {
             clipped_line.push_back(pt.X);
             clipped_line.push_back(pt.Y);
-            vertexBuffer.add(pt.X, pt.Y);
+            addVertex(pt.X, pt.Y);
         }
 
         for (GLsizei i = 0; i < group_count; i++) {
@@ -132,13 +171,19 @@ void FillBucket::tessellate() {
 
         for (GLsizei i = 0; i < vertex_count; ++i) {
             if (vertex_indices[i] == TESS_UNDEF) {
-                vertexBuffer.add(::round(vertices[i * 2]), ::round(vertices[i * 2 + 1]));
+                addVertex(::round(vertices[i * 2]), ::round(vertices[i * 2 + 1]));
                 vertex_indices[i] = (TESSindex)total_vertex_count;
                 total_vertex_count++;
             }
         }
 
-        if (triangleGroups.empty() || (triangleGroups.back()->vertex_length + total_vertex_count > 65535)) {
+        if (total_vertex_count > 65536) {
+            // The tessellator added vertices that 16 bit indices can't address anymore.
+            triangleElementsBuffer.expand();
+        }
+
+        if (triangleGroups.empty() ||
+            (triangleGroups.back()->vertex_length + total_vertex_count > 65535 && !triangleElementsBuffer.expand())) {
             // Move to a new group because the old one can't hold the geometry.
             triangleGroups.emplace_back(std::make_unique<TriangleGroup>());
         }
@@ -187,7 +232,11 @@ void FillBucket::tessellate() {
 }
 
 void FillBucket::upload(gl::GLObjectStore& glObjectStore) {
-    vertexBuffer.upload(glObjectStore);
+    if (featureColors) {
+        colorVertexBuffer.upload(glObjectStore);
+    } else {
+        vertexBuffer.upload(glObjectStore);
+    }
     triangleElementsBuffer.upload(glObjectStore);
     lineElementsBuffer.upload(glObjectStore);
 
@@ -206,38 +255,81 @@ bool FillBucket::hasData() const {
     return !triangleGroups.empty() || !lineGroups.empty();
 }
 
+bool FillBucket::coversTile() const {
+    return tileCovered;
+}
+
 void FillBucket::drawElements(PlainShader& shader, gl::GLObjectStore& glObjectStore) {
+    assert(!featureColors);
     GLbyte* vertex_index = BUFFER_OFFSET(0);
     GLbyte* elements_index = BUFFER_OFFSET(0);
     for (auto& group : triangleGroups) {
         assert(group);
         group->array[0].bind(shader, vertexBuffer, triangleElementsBuffer, vertex_index, glObjectStore);
-        MBGL_CHECK_ERROR(glDrawElements(GL_TRIANGLES, group->elements_length * 3, GL_UNSIGNED_SHORT, elements_index));
+        MBGL_CHECK_ERROR(glDrawElements(GL_TRIANGLES, group->elements_length * 3, triangleElementsBuffer.type(), elements_index + triangleElementsBuffer.getOffset()));
+        glObjectStore.counters.drawCalls++;
         vertex_index += group->vertex_length * vertexBuffer.itemSize;
-        elements_index += group->elements_length * triangleElementsBuffer.itemSize;
+        elements_index += group->elements_length * triangleElementsBuffer.itemSize();
     }
 }
 
 void FillBucket::drawElements(PatternShader& shader, gl::GLObjectStore& glObjectStore) {
+    // The pattern can change with the zoom level and classes, while the bucket layout can't,
+    // so patterns are also drawn from the positions that are interleaved with the colors.
+    const GLsizei itemSize = featureColors ? colorVertexBuffer.itemSize : vertexBuffer.itemSize;
+    shader.stride = featureColors ? itemSize : 0;
+
     GLbyte* vertex_index = BUFFER_OFFSET(0);
     GLbyte* elements_index = BUFFER_OFFSET(0);
     for (auto& group : triangleGroups) {
         assert(group);
-        group->array[1].bind(shader, vertexBuffer, triangleElementsBuffer, vertex_index, glObjectStore);
-        MBGL_CHECK_ERROR(glDrawElements(GL_TRIANGLES, group->elements_length * 3, GL_UNSIGNED_SHORT, elements_index));
-        vertex_index += group->vertex_length * vertexBuffer.itemSize;
-        elements_index += group->elements_length * triangleElementsBuffer.itemSize;
+        if (featureColors) {
+            group->array[3].bind(shader, colorVertexBuffer, triangleElementsBuffer, vertex_index, glObjectStore);
+        } else {
+            group->array[1].bind(shader, vertexBuffer, triangleElementsBuffer, vertex_index, glObjectStore);
+        }
+        MBGL_CHECK_ERROR(glDrawElements(GL_TRIANGLES, group->elements_length * 3, triangleElementsBuffer.type(), elements_index + triangleElementsBuffer.getOffset()));
+        glObjectStore.counters.drawCalls++;
+        vertex_index += group->vertex_length * itemSize;
+        elements_index += group->elements_length * triangleElementsBuffer.itemSize();
+    }
+
+    shader.stride = 0;
+}
+
+void FillBucket::drawElements(FillColorShader& shader, gl::GLObjectStore& glObjectStore) {
+    assert(featureColors);
+    GLbyte* vertex_index = BUFFER_OFFSET(0);
+    GLbyte* elements_index = BUFFER_OFFSET(0);
+    for (auto& group : triangleGroups) {
+        assert(group);
+        group->array[2].bind(shader, colorVertexBuffer, triangleElementsBuffer, vertex_index, glObjectStore);
+        MBGL_CHECK_ERROR(glDrawElements(GL_TRIANGLES, group->elements_length * 3, triangleElementsBuffer.type(), elements_index + triangleElementsBuffer.getOffset()));
+        glObjectStore.counters.drawCalls++;
+        vertex_index += group->vertex_length * colorVertexBuffer.itemSize;
+        elements_index += group->elements_length * triangleElementsBuffer.itemSize();
     }
 }
 
 void FillBucket::drawVertices(OutlineShader& shader, gl::GLObjectStore& glObjectStore) {
+    // With per-feature colors, the positions are only stored interleaved with the colors.
+    const GLsizei itemSize = featureColors ? colorVertexBuffer.itemSize : vertexBuffer.itemSize;
+    shader.stride = featureColors ? itemSize : 0;
+
     GLbyte* vertex_index = BUFFER_OFFSET(0);
     GLbyte* elements_index = BUFFER_OFFSET(0);
     for (auto& group : lineGroups) {
         assert(group);
-        group->array[0].bind(shader, vertexBuffer, lineElementsBuffer, vertex_index, glObjectStore);
-        MBGL_CHECK_ERROR(glDrawElements(GL_LINES, group->elements_length * 2, GL_UNSIGNED_SHORT, elements_index));
-        vertex_index += group->vertex_length * vertexBuffer.itemSize;
-        elements_index += group->elements_length * lineElementsBuffer.itemSize;
+        if (featureColors) {
+            group->array[1].bind(shader, colorVertexBuffer, lineElementsBuffer, vertex_index, glObjectStore);
+        } else {
+            group->array[0].bind(shader, vertexBuffer, lineElementsBuffer, vertex_index, glObjectStore);
+        }
+        MBGL_CHECK_ERROR(glDrawElements(GL_LINES, group->elements_length * 2, lineElementsBuffer.type(), elements_index + lineElementsBuffer.getOffset()));
+        glObjectStore.counters.drawCalls++;
+        vertex_index += group->vertex_length * itemSize;
+        elements_index += group->elements_length * lineElementsBuffer.itemSize();
     }
+
+    shader.stride = 0;
 }
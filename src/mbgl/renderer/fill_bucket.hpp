@@ -5,6 +5,7 @@
 #include <mbgl/tile/geometry_tile.hpp>
 #include <mbgl/geometry/elements_buffer.hpp>
 #include <mbgl/geometry/fill_buffer.hpp>
+#include <mbgl/style/types.hpp>
 
 #include <clipper/clipper.hpp>
 #include <libtess2/tesselator.h>
@@ -15,6 +16,7 @@
 namespace mbgl {
 
 class FillVertexBuffer;
+class FillColorShader;
 class OutlineShader;
 class PlainShader;
 class PatternShader;
@@ -25,8 +27,8 @@ class FillBucket : public Bucket {
     static void *realloc(void *data, void *ptr, unsigned int size);
     static void free(void *userData, void *ptr);
 
-    typedef ElementGroup<2> TriangleGroup;
-    typedef ElementGroup<1> LineGroup;
+    typedef ElementGroup<4> TriangleGroup;
+    typedef ElementGroup<2> LineGroup;
 
 public:
     FillBucket();
@@ -35,28 +37,41 @@ public:
     void upload(gl::GLObjectStore&) override;
     void render(Painter&, const StyleLayer&, const TileID&, const mat4&) override;
     bool hasData() const override;
+    bool coversTile() const override;
 
     void addGeometry(const GeometryCollection&);
+    // Adds geometry whose color is stored in its vertices. A bucket either stores a color
+    // for all of its geometry or for none of it.
+    void addGeometry(const GeometryCollection&, const Color&);
     void tessellate();
 
+    bool hasFeatureColors() const { return featureColors; }
+
     void drawElements(PlainShader&, gl::GLObjectStore&);
     void drawElements(PatternShader&, gl::GLObjectStore&);
+    void drawElements(FillColorShader&, gl::GLObjectStore&);
     void drawVertices(OutlineShader&, gl::GLObjectStore&);
 
 private:
+    void addVertex(FillVertexBuffer::vertex_type x, FillVertexBuffer::vertex_type y);
+
     TESSalloc *allocator;
     TESStesselator *tesselator;
     ClipperLib::Clipper clipper;
 
     FillVertexBuffer vertexBuffer;
-    TriangleElementsBuffer triangleElementsBuffer;
-    LineElementsBuffer lineElementsBuffer;
+    FillColorVertexBuffer colorVertexBuffer;
+    ExpandableElementsBuffer<TriangleElements> triangleElementsBuffer;
+    ExpandableElementsBuffer<LineElements> lineElementsBuffer;
 
     std::vector<std::unique_ptr<TriangleGroup>> triangleGroups;
     std::vector<std::unique_ptr<LineGroup>> lineGroups;
 
     std::vector<ClipperLib::IntPoint> line;
     bool hasVertices = false;
+    bool tileCovered = false;
+    bool featureColors = false;
+    std::array<uint8_t, 4> vertexColor = {{ 0, 0, 0, 0 }};
 
     static const int vertexSize = 2;
     static const int stride = sizeof(TESSreal) * vertexSize;
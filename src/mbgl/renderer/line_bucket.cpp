@@ -351,7 +351,13 @@ void LineBucket::addGeometry(const GeometryCoordinates& vertices) {
 
     // Store the triangle/line groups.
     {
-        if (triangleGroups.empty() || (triangleGroups.back()->vertex_length + vertexCount > 65535)) {
+        if (vertexCount > 65536) {
+            // A single line that 16 bit indices can't address.
+            triangleElementsBuffer.expand();
+        }
+
+        if (triangleGroups.empty() ||
+            (triangleGroups.back()->vertex_length + vertexCount > 65535 && !triangleElementsBuffer.expand())) {
             // Move to a new group because the old one can't hold the geometry.
             triangleGroups.emplace_back(std::make_unique<TriangleGroup>());
         }
@@ -461,10 +467,11 @@ void LineBucket::drawLines(LineShader& shader, gl::GLObjectStore& glObjectStore)
             continue;
         }
         group->array[0].bind(shader, vertexBuffer, triangleElementsBuffer, vertex_index, glObjectStore);
-        MBGL_CHECK_ERROR(glDrawElements(GL_TRIANGLES, group->elements_length * 3, GL_UNSIGNED_SHORT,
-                                        elements_index));
+        MBGL_CHECK_ERROR(glDrawElements(GL_TRIANGLES, group->elements_length * 3, triangleElementsBuffer.type(),
+                                        elements_index + triangleElementsBuffer.getOffset()));
+        glObjectStore.counters.drawCalls++;
         vertex_index += group->vertex_length * vertexBuffer.itemSize;
-        elements_index += group->elements_length * triangleElementsBuffer.itemSize;
+        elements_index += group->elements_length * triangleElementsBuffer.itemSize();
     }
 }
 
@@ -477,10 +484,11 @@ void LineBucket::drawLineSDF(LineSDFShader& shader, gl::GLObjectStore& glObjectS
             continue;
         }
         group->array[2].bind(shader, vertexBuffer, triangleElementsBuffer, vertex_index, glObjectStore);
-        MBGL_CHECK_ERROR(glDrawElements(GL_TRIANGLES, group->elements_length * 3, GL_UNSIGNED_SHORT,
-                                        elements_index));
+        MBGL_CHECK_ERROR(glDrawElements(GL_TRIANGLES, group->elements_length * 3, triangleElementsBuffer.type(),
+                                        elements_index + triangleElementsBuffer.getOffset()));
+        glObjectStore.counters.drawCalls++;
         vertex_index += group->vertex_length * vertexBuffer.itemSize;
-        elements_index += group->elements_length * triangleElementsBuffer.itemSize;
+        elements_index += group->elements_length * triangleElementsBuffer.itemSize();
     }
 }
 
@@ -493,9 +501,10 @@ void LineBucket::drawLinePatterns(LinepatternShader& shader, gl::GLObjectStore&
             continue;
         }
         group->array[1].bind(shader, vertexBuffer, triangleElementsBuffer, vertex_index, glObjectStore);
-        MBGL_CHECK_ERROR(glDrawElements(GL_TRIANGLES, group->elements_length * 3, GL_UNSIGNED_SHORT,
-                                        elements_index));
+        MBGL_CHECK_ERROR(glDrawElements(GL_TRIANGLES, group->elements_length * 3, triangleElementsBuffer.type(),
+                                        elements_index + triangleElementsBuffer.getOffset()));
+        glObjectStore.counters.drawCalls++;
         vertex_index += group->vertex_length * vertexBuffer.itemSize;
-        elements_index += group->elements_length * triangleElementsBuffer.itemSize;
+        elements_index += group->elements_length * triangleElementsBuffer.itemSize();
     }
 }
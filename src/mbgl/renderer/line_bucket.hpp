@@ -15,7 +15,6 @@ namespace mbgl {
 
 class Style;
 class LineVertexBuffer;
-class TriangleElementsBuffer;
 class LineShader;
 class LineSDFShader;
 class LinepatternShader;
@@ -40,8 +39,8 @@ public:
 
 private:
     struct TriangleElement {
-        TriangleElement(uint16_t a_, uint16_t b_, uint16_t c_) : a(a_), b(b_), c(c_) {}
-        uint16_t a, b, c;
+        TriangleElement(uint32_t a_, uint32_t b_, uint32_t c_) : a(a_), b(b_), c(c_) {}
+        uint32_t a, b, c;
     };
     void addCurrentVertex(const GeometryCoordinate& currentVertex, double& distance,
             const vec2<double>& normal, float endLeft, float endRight, bool round,
@@ -55,7 +54,7 @@ public:
 
 private:
     LineVertexBuffer vertexBuffer;
-    TriangleElementsBuffer triangleElementsBuffer;
+    ExpandableElementsBuffer<TriangleElements> triangleElementsBuffer;
 
     GLint e1;
     GLint e2;
@@ -2,6 +2,7 @@
 
 #include <mbgl/source/source.hpp>
 #include <mbgl/tile/tile.hpp>
+#include <mbgl/tile/tile_data.hpp>
 #include <mbgl/map/map_context.hpp>
 #include <mbgl/map/map_data.hpp>
 
@@ -14,6 +15,7 @@
 
 #include <mbgl/layer/background_layer.hpp>
 #include <mbgl/layer/custom_layer.hpp>
+#include <mbgl/layer/fill_layer.hpp>
 
 #include <mbgl/sprite/sprite_atlas.hpp>
 #include <mbgl/geometry/line_atlas.hpp>
@@ -21,6 +23,7 @@
 
 #include <mbgl/shader/pattern_shader.hpp>
 #include <mbgl/shader/plain_shader.hpp>
+#include <mbgl/shader/fillcolor_shader.hpp>
 #include <mbgl/shader/outline_shader.hpp>
 #include <mbgl/shader/line_shader.hpp>
 #include <mbgl/shader/linesdf_shader.hpp>
@@ -39,6 +42,7 @@
 #endif
 
 #include <cassert>
+#include <cstdlib>
 #include <algorithm>
 #include <iostream>
 
@@ -47,23 +51,23 @@ using namespace mbgl;
 Painter::Painter(MapData& data_, TransformState& state_, gl::GLObjectStore& glObjectStore_)
     : data(data_),
       state(state_),
-      glObjectStore(glObjectStore_) {
+      glObjectStore(glObjectStore_),
+      plainShader(glObjectStore),
+      fillColorShader(glObjectStore),
+      outlineShader(glObjectStore),
+      lineShader(glObjectStore),
+      linesdfShader(glObjectStore),
+      linepatternShader(glObjectStore),
+      patternShader(glObjectStore),
+      iconShader(glObjectStore),
+      rasterShader(glObjectStore),
+      sdfGlyphShader(glObjectStore),
+      sdfIconShader(glObjectStore),
+      dotShader(glObjectStore),
+      collisionBoxShader(glObjectStore),
+      circleShader(glObjectStore) {
     gl::debugging::enable();
 
-    plainShader = std::make_unique<PlainShader>(glObjectStore);
-    outlineShader = std::make_unique<OutlineShader>(glObjectStore);
-    lineShader = std::make_unique<LineShader>(glObjectStore);
-    linesdfShader = std::make_unique<LineSDFShader>(glObjectStore);
-    linepatternShader = std::make_unique<LinepatternShader>(glObjectStore);
-    patternShader = std::make_unique<PatternShader>(glObjectStore);
-    iconShader = std::make_unique<IconShader>(glObjectStore);
-    rasterShader = std::make_unique<RasterShader>(glObjectStore);
-    sdfGlyphShader = std::make_unique<SDFGlyphShader>(glObjectStore);
-    sdfIconShader = std::make_unique<SDFIconShader>(glObjectStore);
-    dotShader = std::make_unique<DotShader>(glObjectStore);
-    collisionBoxShader = std::make_unique<CollisionBoxShader>(glObjectStore);
-    circleShader = std::make_unique<CircleShader>(glObjectStore);
-
     // Reset GL values
     config.reset();
 }
@@ -71,7 +75,14 @@ Painter::Painter(MapData& data_, TransformState& state_, gl::GLObjectStore& glOb
 Painter::~Painter() = default;
 
 bool Painter::needsAnimation() const {
-    return frameHistory.needsAnimation(util::DEFAULT_FADE_DURATION);
+    return frameHistory.needsAnimation(util::DEFAULT_FADE_DURATION) || uploadsPending || tilesUploaded;
+}
+
+RenderCounters Painter::counters() const {
+    RenderCounters result = glObjectStore.counters;
+    result.programSwitches = config.program.getChanges();
+    result.stateChanges = config.getStateChanges();
+    return result;
 }
 
 void Painter::prepareTile(const Tile& tile) {
@@ -80,15 +91,18 @@ void Painter::prepareTile(const Tile& tile) {
     config.stencilFunc = { GL_EQUAL, ref, mask };
 }
 
-void Painter::render(const Style& style, const FrameData& frame_, SpriteAtlas& annotationSpriteAtlas) {
+void Painter::render(const Style& style, const FrameData& frame_, SpriteAtlas& annotationSpriteAtlas, FrameProfile& profile) {
     frame = frame_;
 
+    const RenderCounters frameStart = counters();
+    layerCountersSize = 0;
+
     glyphAtlas = style.glyphAtlas.get();
     spriteAtlas = style.spriteAtlas.get();
     lineAtlas = style.lineAtlas.get();
 
     RenderData renderData = style.getRenderData();
-    const std::vector<RenderItem>& order = renderData.order;
+    const std::vector<RenderItem>& order = *renderData.order;
     const std::set<Source*>& sources = renderData.sources;
     const Color& background = renderData.backgroundColor;
 
@@ -105,22 +119,21 @@ void Painter::render(const Style& style, const FrameData& frame_, SpriteAtlas& a
 
     // - UPLOAD PASS -------------------------------------------------------------------------------
     // Uploads all required buffers and images before we do any actual rendering.
+    TimePoint phaseStart = Clock::now();
     {
         MBGL_DEBUG_GROUP("upload");
 
         tileStencilBuffer.upload(glObjectStore);
         tileBorderBuffer.upload(glObjectStore);
+        quadElementsBuffer.upload(glObjectStore);
         spriteAtlas->upload(glObjectStore);
         lineAtlas->upload(glObjectStore);
         glyphAtlas->upload(glObjectStore);
         annotationSpriteAtlas.upload(glObjectStore);
 
-        for (const auto& item : order) {
-            if (item.bucket && item.bucket->needsUpload()) {
-                item.bucket->upload(glObjectStore);
-            }
-        }
+        uploadBuckets(order, sources);
     }
+    profile.upload = Clock::now() - phaseStart;
 
     // - CLEAR -------------------------------------------------------------------------------------
     // Renders the backdrop of the OpenGL view. This also paints in areas where we don't have any
@@ -141,18 +154,21 @@ void Painter::render(const Style& style, const FrameData& frame_, SpriteAtlas& a
 
     // - CLIPPING MASKS ----------------------------------------------------------------------------
     // Draws the clipping masks to the stencil buffer.
+    phaseStart = Clock::now();
     {
         MBGL_DEBUG_GROUP("clip");
 
         // Update all clipping IDs.
-        ClipIDGenerator generator;
+        std::vector<std::forward_list<Tile*>> loadedTiles;
         for (const auto& source : sources) {
-            generator.update(source->getLoadedTiles());
+            loadedTiles.push_back(source->getLoadedTiles());
             source->updateMatrices(projMatrix, state);
         }
+        clipIDs.update(loadedTiles);
 
-        drawClippingMasks(generator.getStencils());
+        drawClippingMasks(clipIDs.getStencils());
     }
+    profile.clip = Clock::now() - phaseStart;
 
     frameHistory.record(frame.timePoint, state.getZoom());
 
@@ -162,22 +178,29 @@ void Painter::render(const Style& style, const FrameData& frame_, SpriteAtlas& a
     // TODO: Correctly compute the number of layers recursively beforehand.
     depthRangeSize = 1 - (order.size() + 2) * numSublayers * depthEpsilon;
 
+    findTileOccluders(order);
+
     // - OPAQUE PASS -------------------------------------------------------------------------------
     // Render everything top-to-bottom by using reverse iterators. Render opaque objects first.
+    phaseStart = Clock::now();
     renderPass(RenderPass::Opaque,
                order.rbegin(), order.rend(),
                0, 1);
+    profile.opaquePass = Clock::now() - phaseStart;
 
     // - TRANSLUCENT PASS --------------------------------------------------------------------------
     // Make a second pass, rendering translucent objects. This time, we render bottom-to-top.
+    phaseStart = Clock::now();
     renderPass(RenderPass::Translucent,
                order.begin(), order.end(),
                static_cast<GLsizei>(order.size()) - 1, -1);
+    profile.translucentPass = Clock::now() - phaseStart;
 
     if (debug::renderTree) { Log::Info(Event::Render, "}"); indent--; }
 
     // - DEBUG PASS --------------------------------------------------------------------------------
     // Renders debug overlays.
+    phaseStart = Clock::now();
     {
         MBGL_DEBUG_GROUP("debug");
 
@@ -189,6 +212,7 @@ void Painter::render(const Style& style, const FrameData& frame_, SpriteAtlas& a
             source->finishRender(*this);
         }
     }
+    profile.debugPass = Clock::now() - phaseStart;
 
     // TODO: Find a better way to unbind VAOs after we're done with them without introducing
     // unnecessary bind(0)/bind(N) sequences.
@@ -196,12 +220,105 @@ void Painter::render(const Style& style, const FrameData& frame_, SpriteAtlas& a
         MBGL_DEBUG_GROUP("cleanup");
 
         MBGL_CHECK_ERROR(glBindTexture(GL_TEXTURE_2D, 0));
+        glObjectStore.counters.textureBinds++;
         MBGL_CHECK_ERROR(VertexArrayObject::Unbind());
     }
 
     if (data.contextMode == GLContextMode::Shared) {
         config.setDirty();
     }
+
+    frameCounters = counters() - frameStart;
+}
+
+RenderStatistics Painter::getStatistics() const {
+    RenderStatistics result;
+    result.total = frameCounters;
+    for (std::size_t i = 0; i < layerCountersSize; i++) {
+        result.layers[layerCounters[i].id] += layerCounters[i].counters;
+    }
+    return result;
+}
+
+void Painter::uploadBuckets(const std::vector<RenderItem>& order, const std::set<Source*>& sources) {
+    std::vector<TileData*> pendingTiles;
+
+    for (const auto& item : order) {
+        if (!item.bucket || !item.bucket->needsUpload()) {
+            continue;
+        }
+
+        TileData* tileData = item.tile->data.get();
+        if (tileData->uploaded) {
+            // New data for a tile that is already on screen, e.g. after symbol placement or a
+            // reparse. Upload it right away so that the tile doesn't disappear.
+            item.bucket->upload(glObjectStore);
+        } else if (std::find(pendingTiles.begin(), pendingTiles.end(), tileData) == pendingTiles.end()) {
+            pendingTiles.push_back(tileData);
+        }
+    }
+
+    // Tiles at the current zoom level go first; tiles at other zoom levels only stand in for
+    // them while they are loading.
+    const int32_t zoom = state.getIntegerZoom();
+    std::stable_sort(pendingTiles.begin(), pendingTiles.end(), [&](const TileData* a, const TileData* b) {
+        return std::abs(a->id.z - zoom) < std::abs(b->id.z - zoom);
+    });
+
+    tilesUploaded = false;
+
+    const TimePoint start = Clock::now();
+    auto it = pendingTiles.begin();
+    for (; it != pendingTiles.end(); ++it) {
+        if (it != pendingTiles.begin() && data.mode != MapMode::Still && Clock::now() - start >= uploadBudget) {
+            break;
+        }
+
+        for (const auto& item : order) {
+            if (item.bucket && item.tile->data.get() == *it && item.bucket->needsUpload()) {
+                item.bucket->upload(glObjectStore);
+            }
+        }
+        (*it)->uploaded = true;
+        tilesUploaded = true;
+    }
+
+    uploadsPending = it != pendingTiles.end();
+
+    // Tiles that don't have anything to upload for the current style are ready to be drawn.
+    for (const auto& source : sources) {
+        for (const auto& tile : source->getTiles()) {
+            TileData* tileData = tile->data.get();
+            if (tileData && !tileData->uploaded && tileData->isReady() &&
+                std::find(it, pendingTiles.end(), tileData) == pendingTiles.end()) {
+                tileData->uploaded = true;
+                tilesUploaded = true;
+            }
+        }
+    }
+}
+
+void Painter::findTileOccluders(const std::vector<RenderItem>& order) {
+    tileOccluders.clear();
+
+    // The opaque pass draws top-to-bottom, so the depth test already discards most fragments
+    // below opaque fills. Skipping the hidden layers altogether also saves their draw calls and
+    // vertex work, as well as their translucent fragments.
+    GLsizei i = 0;
+    for (auto it = order.rbegin(); it != order.rend(); ++it, ++i) {
+        const RenderItem& item = *it;
+        if (!item.bucket || !item.tile->data->uploaded || !item.bucket->coversTile()) {
+            continue;
+        }
+
+        if (item.layer.is<FillLayer>() && item.layer.hasRenderPass(RenderPass::Opaque)) {
+            const std::array<float, 2> translate = item.layer.as<FillLayer>()->paint.translate;
+            if (translate[0] == 0 && translate[1] == 0) {
+                // Doesn't replace a layer further up in the same tile.
+                tileOccluders.emplace(item.tile, i);
+            }
+        }
+    }
 }
 
 template <class Iterator>
@@ -217,6 +334,8 @@ void Painter::renderPass(RenderPass pass_,
                   pass == RenderPass::Opaque ? "opaque" : "translucent");
     }
 
+    // Every item gets its own draw calls: each bucket's vertices live in a buffer range of
+    // their own, in tile coordinates, and are clipped with the tile's stencil reference.
     for (; it != end; ++it, i += increment) {
         currentLayer = i;
 
@@ -226,8 +345,17 @@ void Painter::renderPass(RenderPass pass_,
         if (!layer.hasRenderPass(pass))
             continue;
 
+        if (item.tile) {
+            auto occluder = tileOccluders.find(item.tile);
+            if (occluder != tileOccluders.end() && occluder->second < i) {
+                continue;
+            }
+        }
+
+        const RenderCounters itemStart = counters();
+
         if (pass == RenderPass::Translucent) {
-            config.blendFunc.reset();
+            config.blendFunc.setDefault();
             config.blend = GL_TRUE;
         } else {
             config.blend = GL_FALSE;
@@ -244,11 +372,27 @@ void Painter::renderPass(RenderPass pass_,
             VertexArrayObject::Unbind();
             layer.as<CustomLayer>()->render(state);
             config.setDirty();
+        } else if (!item.tile->data->uploaded) {
+            // Still waiting for its upload; Source keeps parent or child tiles around to
+            // cover it in the meantime.
+            continue;
         } else {
             MBGL_DEBUG_GROUP(layer.id + " - " + std::string(item.tile->id));
             prepareTile(*item.tile);
             item.bucket->render(*this, layer, item.tile->id, item.tile->matrix);
         }
+
+        // The items of a layer are adjacent in the render order, so they share an entry.
+        if (layerCountersSize == 0 || layerCounters[layerCountersSize - 1].layer != &layer) {
+            if (layerCountersSize == layerCounters.size()) {
+                layerCounters.emplace_back();
+            }
+            LayerCounters& entry = layerCounters[layerCountersSize++];
+            entry.layer = &layer;
+            entry.id = layer.id;
+            entry.counters = RenderCounters();
+        }
+        layerCounters[layerCountersSize - 1].counters += counters() - itemStart;
     }
 
     if (debug::renderTree) {
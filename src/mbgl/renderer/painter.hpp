@@ -3,26 +3,33 @@
 
 #include <mbgl/map/transform_state.hpp>
 #include <mbgl/map/map_context.hpp>
+#include <mbgl/map/render_statistics.hpp>
+#include <mbgl/map/frame_profile.hpp>
 
 #include <mbgl/renderer/frame_history.hpp>
 #include <mbgl/renderer/bucket.hpp>
 
 #include <mbgl/geometry/vao.hpp>
 #include <mbgl/geometry/static_vertex_buffer.hpp>
+#include <mbgl/geometry/elements_buffer.hpp>
 
 #include <mbgl/gl/gl_config.hpp>
 
+#include <mbgl/shader/shader.hpp>
+
 #include <mbgl/style/types.hpp>
 
 #include <mbgl/gl/gl.hpp>
 
 #include <mbgl/util/noncopyable.hpp>
 #include <mbgl/util/chrono.hpp>
+#include <mbgl/util/clip_id.hpp>
 #include <mbgl/util/constants.hpp>
 
 #include <array>
 #include <vector>
 #include <set>
+#include <unordered_map>
 
 namespace mbgl {
 
@@ -50,6 +57,7 @@ class BackgroundLayer;
 
 class SDFShader;
 class PlainShader;
+class FillColorShader;
 class OutlineShader;
 class LineShader;
 class LinejoinShader;
@@ -64,8 +72,6 @@ class SDFIconShader;
 class DotShader;
 class CollisionBoxShader;
 
-struct ClipID;
-
 namespace util {
 class GLObjectStore;
 }
@@ -75,9 +81,11 @@ public:
     Painter(MapData&, TransformState&, gl::GLObjectStore&);
     ~Painter();
 
+    // Records the time spent in each render phase in the profile.
     void render(const Style& style,
                 const FrameData& frame,
-                SpriteAtlas& annotationSpriteAtlas);
+                SpriteAtlas& annotationSpriteAtlas,
+                FrameProfile& profile);
 
     // Renders debug information for a tile.
     void renderTileDebug(const Tile& tile);
@@ -101,11 +109,24 @@ public:
 
     bool needsAnimation() const;
 
+    // Counters for the most recently rendered frame.
+    RenderStatistics getStatistics() const;
+
 private:
+    // Running totals of everything issued through this painter's context.
+    RenderCounters counters() const;
+
     mat4 translatedMatrix(const mat4& matrix, const std::array<float, 2> &translation, const TileID &id, TranslateAnchorType anchor);
 
     std::vector<RenderItem> determineRenderOrder(const Style& style);
 
+    // Uploads the buckets of the tiles we're about to render. Tiles that are rendered for the
+    // first time are uploaded one at a time until the frame's upload budget is spent.
+    void uploadBuckets(const std::vector<RenderItem>&, const std::set<Source*>&);
+
+    // Finds the topmost layer in each tile that is opaque and covers the entire tile.
+    void findTileOccluders(const std::vector<RenderItem>&);
+
     template <class Iterator>
     void renderPass(RenderPass,
                     Iterator it, Iterator end,
@@ -122,7 +143,7 @@ private:
                    float scaleDivisor,
                    std::array<float, 2> texsize,
                    SDFShader& sdfShader,
-                   void (SymbolBucket::*drawSDF)(SDFShader&, gl::GLObjectStore&));
+                   void (SymbolBucket::*drawSDF)(SDFShader&, QuadElementsBuffer&, gl::GLObjectStore&));
 
     void setDepthSublayer(int n);
 
@@ -159,6 +180,12 @@ private:
     int numSublayers = 3;
     GLsizei currentLayer;
     float depthRangeSize;
+
+    ClipIDCache clipIDs;
+
+    // Per tile, the layer (counted from the top, like currentLayer) that hides everything below
+    // it in that tile. Layers below it aren't drawn in either pass.
+    std::unordered_map<const Tile*, GLsizei> tileOccluders;
     const float depthEpsilon = 1.0f / (1 << 16);
 
     SpriteAtlas* spriteAtlas = nullptr;
@@ -167,19 +194,41 @@ private:
 
     FrameHistory frameHistory;
 
-    std::unique_ptr<PlainShader> plainShader;
-    std::unique_ptr<OutlineShader> outlineShader;
-    std::unique_ptr<LineShader> lineShader;
-    std::unique_ptr<LineSDFShader> linesdfShader;
-    std::unique_ptr<LinepatternShader> linepatternShader;
-    std::unique_ptr<PatternShader> patternShader;
-    std::unique_ptr<IconShader> iconShader;
-    std::unique_ptr<RasterShader> rasterShader;
-    std::unique_ptr<SDFGlyphShader> sdfGlyphShader;
-    std::unique_ptr<SDFIconShader> sdfIconShader;
-    std::unique_ptr<DotShader> dotShader;
-    std::unique_ptr<CollisionBoxShader> collisionBoxShader;
-    std::unique_ptr<CircleShader> circleShader;
+    RenderCounters frameCounters;
+
+    // Counters of the layers rendered in the most recent frame, in render order. A layer that
+    // is drawn in both passes has an entry for each. The entries are reused from frame to
+    // frame, and only collected into RenderStatistics when they're asked for.
+    struct LayerCounters {
+        const StyleLayer* layer = nullptr;
+        std::string id;
+        RenderCounters counters;
+    };
+    std::vector<LayerCounters> layerCounters;
+    std::size_t layerCountersSize = 0;
+
+    // Time per frame we spend uploading tiles that are new on screen. At least one tile is
+    // uploaded per frame regardless; still images upload everything at once.
+    const Duration uploadBudget = std::chrono::duration_cast<Duration>(Milliseconds(4));
+    bool uploadsPending = false;
+    // Set when a tile became ready to draw this frame. Sources only drop the parent and child
+    // tiles that stand in for it on their next update, so this frame needs a follow-up.
+    bool tilesUploaded = false;
+
+    LazyShader<PlainShader> plainShader;
+    LazyShader<FillColorShader> fillColorShader;
+    LazyShader<OutlineShader> outlineShader;
+    LazyShader<LineShader> lineShader;
+    LazyShader<LineSDFShader> linesdfShader;
+    LazyShader<LinepatternShader> linepatternShader;
+    LazyShader<PatternShader> patternShader;
+    LazyShader<IconShader> iconShader;
+    LazyShader<RasterShader> rasterShader;
+    LazyShader<SDFGlyphShader> sdfGlyphShader;
+    LazyShader<SDFIconShader> sdfIconShader;
+    LazyShader<DotShader> dotShader;
+    LazyShader<CollisionBoxShader> collisionBoxShader;
+    LazyShader<CircleShader> circleShader;
 
     // Set up the stencil quad we're using to generate the stencil mask.
     StaticVertexBuffer tileStencilBuffer = {
@@ -209,6 +258,9 @@ private:
     };
 
     VertexArrayObject tileBorderArray;
+
+    // Indices of the quads that symbol buckets are made of.
+    QuadElementsBuffer quadElementsBuffer;
 };
 
 } // namespace mbgl
@@ -49,7 +49,7 @@ void Painter::renderBackground(const BackgroundLayer& layer) {
     }
 
     config.stencilTest = GL_FALSE;
-    config.depthFunc.reset();
+    config.depthFunc.setDefault();
     config.depthTest = GL_TRUE;
     config.depthMask = GL_FALSE;
     setDepthSublayer(0);
@@ -100,6 +100,7 @@ void Painter::renderBackground(const BackgroundLayer& layer) {
         }
 
         MBGL_CHECK_ERROR(glDrawArrays(GL_TRIANGLE_STRIP, 0, (GLsizei)tileStencilBuffer.index()));
+        glObjectStore.counters.drawCalls++;
     }
 
 }
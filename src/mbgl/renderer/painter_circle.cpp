@@ -18,7 +18,7 @@ void Painter::renderCircle(CircleBucket& bucket,
     if (pass == RenderPass::Opaque) return;
 
     config.stencilTest = GL_FALSE;
-    config.depthFunc.reset();
+    config.depthFunc.setDefault();
     config.depthTest = GL_TRUE;
     config.depthMask = GL_FALSE;
     setDepthSublayer(0);
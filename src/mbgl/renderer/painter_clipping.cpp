@@ -14,7 +14,7 @@ void Painter::drawClippingMasks(const std::map<TileID, ClipID>& stencils) {
     const GLuint mask = 0b11111111;
 
     config.program = plainShader->getID();
-    config.stencilOp.reset();
+    config.stencilOp.setDefault();
     config.stencilTest = GL_TRUE;
     config.depthTest = GL_FALSE;
     config.depthMask = GL_FALSE;
@@ -35,5 +35,6 @@ void Painter::drawClippingMasks(const std::map<TileID, ClipID>& stencils) {
         const GLint ref = (GLint)(clip.reference.to_ulong());
         config.stencilFunc = { GL_ALWAYS, ref, mask };
         MBGL_CHECK_ERROR(glDrawArrays(GL_TRIANGLES, 0, (GLsizei)tileStencilBuffer.index()));
+        glObjectStore.counters.drawCalls++;
     }
 }
@@ -52,7 +52,7 @@ void Painter::renderDebugText(TileData& tileData, const mat4 &matrix) {
     config.lineWidth = 2.0f * data.pixelRatio;
     tileData.debugBucket->drawLines(*plainShader, glObjectStore);
 
-    config.depthFunc.reset();
+    config.depthFunc.setDefault();
     config.depthTest = GL_TRUE;
 }
 
@@ -63,7 +63,7 @@ void Painter::renderDebugFrame(const mat4 &matrix) {
     // but *don't* disable stencil test, as we want to clip the red tile border
     // to the tile viewport.
     config.depthTest = GL_FALSE;
-    config.stencilOp.reset();
+    config.stencilOp.setDefault();
     config.stencilTest = GL_TRUE;
 
     config.program = plainShader->getID();
@@ -74,4 +74,5 @@ void Painter::renderDebugFrame(const mat4 &matrix) {
     plainShader->u_color = {{ 1.0f, 0.0f, 0.0f, 1.0f }};
     config.lineWidth = 4.0f * data.pixelRatio;
     MBGL_CHECK_ERROR(glDrawArrays(GL_LINE_STRIP, 0, (GLsizei)tileBorderBuffer.index()));
+    glObjectStore.counters.drawCalls++;
 }
@@ -6,6 +6,7 @@
 #include <mbgl/shader/outline_shader.hpp>
 #include <mbgl/shader/pattern_shader.hpp>
 #include <mbgl/shader/plain_shader.hpp>
+#include <mbgl/shader/fillcolor_shader.hpp>
 
 using namespace mbgl;
 
@@ -31,12 +32,16 @@ void Painter::renderFill(FillBucket& bucket, const FillLayer& layer, const TileI
 
     const bool pattern = !properties.pattern.value.from.empty();
 
+    // With per-feature colors, the fringe would need the feature colors as well, so only
+    // outlines with a color of their own are drawn.
+    const bool featureColors = bucket.hasFeatureColors();
+
     bool outline = properties.antialias && !pattern && stroke_color != fill_color;
-    bool fringeline = properties.antialias && !pattern && stroke_color == fill_color;
+    bool fringeline = properties.antialias && !pattern && stroke_color == fill_color && !featureColors;
 
-    config.stencilOp.reset();
+    config.stencilOp.setDefault();
     config.stencilTest = GL_TRUE;
-    config.depthFunc.reset();
+    config.depthFunc.setDefault();
     config.depthTest = GL_TRUE;
     config.depthMask = GL_TRUE;
 
@@ -58,6 +63,7 @@ void Painter::renderFill(FillBucket& bucket, const FillLayer& layer, const TileI
         bucket.drawVertices(*outlineShader, glObjectStore);
     }
 
+    // A pattern replaces the fill color, including per-feature colors.
     if (pattern) {
         optional<SpriteAtlasPosition> posA = spriteAtlas->getPosition(properties.pattern.value.from, true);
         optional<SpriteAtlasPosition> posB = spriteAtlas->getPosition(properties.pattern.value.to, true);
@@ -112,6 +118,18 @@ void Painter::renderFill(FillBucket& bucket, const FillLayer& layer, const TileI
             bucket.drawElements(*patternShader, glObjectStore);
         }
     }
+    else if (featureColors) {
+        // The layer is either opaque or translucent as a whole; see FillLayer::recalculate.
+        if (layer.hasRenderPass(RenderPass::Opaque) == (pass == RenderPass::Opaque)) {
+            config.program = fillColorShader->getID();
+            fillColorShader->u_matrix = vtxMatrix;
+            fillColorShader->u_opacity = properties.opacity;
+
+            // Draw the actual triangles into the color & stencil buffer.
+            setDepthSublayer(1);
+            bucket.drawElements(*fillColorShader, glObjectStore);
+        }
+    }
     else {
         // No image fill.
         if ((fill_color[3] >= 1.0f) == (pass == RenderPass::Opaque)) {
@@ -16,9 +16,9 @@ void Painter::renderLine(LineBucket& bucket, const LineLayer& layer, const TileI
     // Abort early.
     if (pass == RenderPass::Opaque) return;
 
-    config.stencilOp.reset();
+    config.stencilOp.setDefault();
     config.stencilTest = GL_TRUE;
-    config.depthFunc.reset();
+    config.depthFunc.setDefault();
     config.depthTest = GL_TRUE;
     config.depthMask = GL_FALSE;
 
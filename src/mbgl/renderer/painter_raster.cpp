@@ -22,9 +22,9 @@ void Painter::renderRaster(RasterBucket& bucket, const RasterLayer& layer, const
         rasterShader->u_contrast_factor = contrastFactor(properties.contrast);
         rasterShader->u_spin_weights = spinWeights(properties.hueRotate);
 
-        config.stencilOp.reset();
+        config.stencilOp.setDefault();
         config.stencilTest = GL_TRUE;
-        config.depthFunc.reset();
+        config.depthFunc.setDefault();
         config.depthTest = GL_TRUE;
         config.depthMask = GL_FALSE;
         setDepthSublayer(0);
@@ -23,7 +23,7 @@ void Painter::renderSDF(SymbolBucket &bucket,
                         float sdfFontSize,
                         std::array<float, 2> texsize,
                         SDFShader& sdfShader,
-                        void (SymbolBucket::*drawSDF)(SDFShader&, gl::GLObjectStore&))
+                        void (SymbolBucket::*drawSDF)(SDFShader&, QuadElementsBuffer&, gl::GLObjectStore&))
 {
     mat4 vtxMatrix = translatedMatrix(matrix, styleProperties.translate, id, styleProperties.translateAnchor);
 
@@ -101,7 +101,7 @@ void Painter::renderSDF(SymbolBucket &bucket,
         sdfShader.u_buffer = (haloOffset - styleProperties.haloWidth / fontScale) / sdfPx;
 
         setDepthSublayer(0);
-        (bucket.*drawSDF)(sdfShader, glObjectStore);
+        (bucket.*drawSDF)(sdfShader, quadElementsBuffer, glObjectStore);
     }
 
     // Then, we draw the text/icon over the halo
@@ -122,7 +122,7 @@ void Painter::renderSDF(SymbolBucket &bucket,
         sdfShader.u_buffer = (256.0f - 64.0f) / 256.0f;
 
         setDepthSublayer(1);
-        (bucket.*drawSDF)(sdfShader, glObjectStore);
+        (bucket.*drawSDF)(sdfShader, quadElementsBuffer, glObjectStore);
     }
 }
 
@@ -149,13 +149,13 @@ void Painter::renderSymbol(SymbolBucket& bucket, const SymbolLayer& layer, const
     if (drawAcrossEdges) {
         config.stencilTest = GL_FALSE;
     } else {
-        config.stencilOp.reset();
+        config.stencilOp.setDefault();
         config.stencilTest = GL_TRUE;
     }
 
     if (bucket.hasIconData()) {
         if (layout.icon.rotationAlignment == RotationAlignmentType::Map) {
-            config.depthFunc.reset();
+            config.depthFunc.setDefault();
             config.depthTest = GL_TRUE;
         } else {
             config.depthTest = GL_FALSE;
@@ -230,13 +230,13 @@ void Painter::renderSymbol(SymbolBucket& bucket, const SymbolLayer& layer, const
             iconShader->u_opacity = properties.icon.opacity;
 
             setDepthSublayer(0);
-            bucket.drawIcons(*iconShader, glObjectStore);
+            bucket.drawIcons(*iconShader, quadElementsBuffer, glObjectStore);
         }
     }
 
     if (bucket.hasTextData()) {
         if (layout.text.rotationAlignment == RotationAlignmentType::Map) {
-            config.depthFunc.reset();
+            config.depthFunc.setDefault();
             config.depthTest = GL_TRUE;
         } else {
             config.depthTest = GL_FALSE;
@@ -256,7 +256,7 @@ void Painter::renderSymbol(SymbolBucket& bucket, const SymbolLayer& layer, const
     }
 
     if (bucket.hasCollisionBoxData()) {
-        config.stencilOp.reset();
+        config.stencilOp.setDefault();
         config.stencilTest = GL_TRUE;
 
         config.program = collisionBoxShader->getID();
@@ -32,6 +32,7 @@ void RasterBucket::drawRaster(RasterShader& shader, StaticVertexBuffer &vertices
     shader.u_image = 0;
     array.bind(shader, vertices, BUFFER_OFFSET_0, glObjectStore);
     MBGL_CHECK_ERROR(glDrawArrays(GL_TRIANGLES, 0, (GLsizei)vertices.index()));
+    glObjectStore.counters.drawCalls++;
 }
 
 bool RasterBucket::hasData() const {
@@ -27,6 +27,8 @@
 #include <mbgl/util/get_geometries.hpp>
 #include <mbgl/util/constants.hpp>
 
+#include <algorithm>
+
 namespace mbgl {
 
 SymbolInstance::SymbolInstance(Anchor& anchor, const GeometryCoordinates& line,
@@ -70,11 +72,9 @@ SymbolBucket::~SymbolBucket() {
 void SymbolBucket::upload(gl::GLObjectStore& glObjectStore) {
     if (hasTextData()) {
         renderData->text.vertices.upload(glObjectStore);
-        renderData->text.triangles.upload(glObjectStore);
     }
     if (hasIconData()) {
         renderData->icon.vertices.upload(glObjectStore);
-        renderData->icon.triangles.upload(glObjectStore);
     }
 
     uploaded = true;
@@ -95,8 +95,27 @@ bool SymbolBucket::hasIconData() const { return renderData && !renderData->icon.
 
 bool SymbolBucket::hasCollisionBoxData() const { return renderData && !renderData->collisionBox.groups.empty(); }
 
+namespace {
+
+bool isASCII(const std::string& string) {
+    return std::all_of(string.begin(), string.end(), [] (char c) {
+        return static_cast<unsigned char>(c) < 0x80;
+    });
+}
+
+// ASCII letters don't need the platform's Unicode case mapping.
+void transformASCII(std::string& string, char from, char to) {
+    for (char& c : string) {
+        if (c >= from && c < from + 26) {
+            c = to + (c - from);
+        }
+    }
+}
+
+} // namespace
+
 void SymbolBucket::parseFeatures(const GeometryTileLayer& layer,
-                                 const FilterExpression& filter) {
+                                 const CompiledFilter& filter) {
     const bool has_text = !layout.text.field.value.empty() && !layout.text.font.value.empty();
     const bool has_icon = !layout.icon.image.value.empty();
 
@@ -104,43 +123,74 @@ void SymbolBucket::parseFeatures(const GeometryTileLayer& layer,
         return;
     }
 
+    // Split the templates into text and tokens once for all features.
+    const util::TokenString textField(layout.text.field);
+    const util::TokenString iconImage(layout.icon.image);
+    std::string u8string;
+    optional<GlyphRange> lastRange;
+
     // Determine and load glyph ranges
+    CompiledFilter::Scratch scratch;
     const GLsizei featureCount = static_cast<GLsizei>(layer.featureCount());
     for (GLsizei i = 0; i < featureCount; i++) {
         auto feature = layer.getFeature(i);
 
         GeometryTileFeatureExtractor extractor(*feature);
-        if (!evaluate(filter, extractor))
+        if (!filter.evaluate(extractor, scratch))
             continue;
 
         SymbolFeature ft;
 
-        auto getValue = [&feature](const std::string& key) -> std::string {
-            auto value = feature->getValue(key);
-            return value ? toString(*value) : std::string();
+        auto appendValue = [&feature](const std::string& key, std::string& result) {
+            const Value* value = feature->findValue(key);
+            if (!value) {
+                return;
+            } else if (value->is<std::string>()) {
+                result.append(value->get<std::string>());
+            } else {
+                result.append(toString(*value));
+            }
         };
 
         if (has_text) {
-            std::string u8string = util::replaceTokens(layout.text.field, getValue);
+            u8string.clear();
+            textField.appendTo(u8string, appendValue);
+
+            const bool ascii = isASCII(u8string);
 
             if (layout.text.transform == TextTransformType::Uppercase) {
-                u8string = platform::uppercase(u8string);
+                if (ascii) {
+                    transformASCII(u8string, 'a', 'A');
+                } else {
+                    u8string = platform::uppercase(u8string);
+                }
             } else if (layout.text.transform == TextTransformType::Lowercase) {
-                u8string = platform::lowercase(u8string);
+                if (ascii) {
+                    transformASCII(u8string, 'A', 'a');
+                } else {
+                    u8string = platform::lowercase(u8string);
+                }
             }
 
-            ft.label = util::utf8_to_utf32::convert(u8string);
+            if (ascii) {
+                ft.label.assign(u8string.begin(), u8string.end());
+            } else {
+                ft.label = util::utf8_to_utf32::convert(u8string);
+            }
 
-            if (!ft.label.empty()) {
-                // Loop through all characters of this text and collect unique codepoints.
-                for (char32_t chr : ft.label) {
-                    ranges.insert(getGlyphRange(chr));
+            // Collect the glyph ranges of all characters. Consecutive characters are usually
+            // in the same range, so skip the set lookup for them.
+            for (char32_t chr : ft.label) {
+                const GlyphRange range = getGlyphRange(chr);
+                if (range != lastRange) {
+                    ranges.insert(range);
+                    lastRange = range;
                 }
             }
         }
 
         if (has_icon) {
-            ft.sprite = util::replaceTokens(layout.icon.image, getValue);
+            iconImage.appendTo(ft.sprite, appendValue);
         }
 
         if (ft.label.length() || ft.sprite.length()) {
@@ -488,16 +538,15 @@ void SymbolBucket::addSymbols(Buffer &buffer, const SymbolQuads &symbols, float
 
         const int glyph_vertex_length = 4;
 
+        static_assert(QuadElementsBuffer::maxQuads * glyph_vertex_length >= 65535,
+                      "shared quad indices must cover a whole group");
         if (buffer.groups.empty() || (buffer.groups.back()->vertex_length + glyph_vertex_length > 65535)) {
             // Move to a new group because the old one can't hold the geometry.
             buffer.groups.emplace_back(std::make_unique<GroupType>());
         }
 
-        // We're generating triangle fans, so we always start with the first
-        // coordinate in this polygon.
         assert(buffer.groups.back());
         auto &triangleGroup = *buffer.groups.back();
-        GLsizei triangleIndex = triangleGroup.vertex_length;
 
         // coordinates (2 triangles)
         buffer.vertices.add(anchorPoint.x, anchorPoint.y, tl.x, tl.y, tex.x, tex.y, minZoom,
@@ -509,10 +558,8 @@ void SymbolBucket::addSymbols(Buffer &buffer, const SymbolQuads &symbols, float
         buffer.vertices.add(anchorPoint.x, anchorPoint.y, br.x, br.y, tex.x + tex.w, tex.y + tex.h,
                             minZoom, maxZoom, placementZoom);
 
-        // add the two triangles, referencing the four coordinates we just inserted.
-        buffer.triangles.add(triangleIndex + 0, triangleIndex + 1, triangleIndex + 2);
-        buffer.triangles.add(triangleIndex + 1, triangleIndex + 2, triangleIndex + 3);
-
+        // The two triangles referencing the four coordinates we just inserted are part of the
+        // shared QuadElementsBuffer.
         triangleGroup.vertex_length += glyph_vertex_length;
         triangleGroup.elements_length += 2;
     }
@@ -576,42 +623,39 @@ void SymbolBucket::swapRenderData() {
     }
 }
 
-void SymbolBucket::drawGlyphs(SDFShader& shader, gl::GLObjectStore& glObjectStore) {
+void SymbolBucket::drawGlyphs(SDFShader& shader, QuadElementsBuffer& quads, gl::GLObjectStore& glObjectStore) {
     GLbyte *vertex_index = BUFFER_OFFSET_0;
-    GLbyte *elements_index = BUFFER_OFFSET_0;
     auto& text = renderData->text;
     for (auto &group : text.groups) {
         assert(group);
-        group->array[0].bind(shader, text.vertices, text.triangles, vertex_index, glObjectStore);
-        MBGL_CHECK_ERROR(glDrawElements(GL_TRIANGLES, group->elements_length * 3, GL_UNSIGNED_SHORT, elements_index));
+        group->array[0].bind(shader, text.vertices, quads, vertex_index, glObjectStore);
+        MBGL_CHECK_ERROR(glDrawElements(GL_TRIANGLES, group->elements_length * 3, GL_UNSIGNED_SHORT, BUFFER_OFFSET(quads.getOffset())));
+        glObjectStore.counters.drawCalls++;
         vertex_index += group->vertex_length * text.vertices.itemSize;
-        elements_index += group->elements_length * text.triangles.itemSize;
     }
 }
 
-void SymbolBucket::drawIcons(SDFShader& shader, gl::GLObjectStore& glObjectStore) {
+void SymbolBucket::drawIcons(SDFShader& shader, QuadElementsBuffer& quads, gl::GLObjectStore& glObjectStore) {
     GLbyte *vertex_index = BUFFER_OFFSET_0;
-    GLbyte *elements_index = BUFFER_OFFSET_0;
     auto& icon = renderData->icon;
     for (auto &group : icon.groups) {
         assert(group);
-        group->array[0].bind(shader, icon.vertices, icon.triangles, vertex_index, glObjectStore);
-        MBGL_CHECK_ERROR(glDrawElements(GL_TRIANGLES, group->elements_length * 3, GL_UNSIGNED_SHORT, elements_index));
+        group->array[0].bind(shader, icon.vertices, quads, vertex_index, glObjectStore);
+        MBGL_CHECK_ERROR(glDrawElements(GL_TRIANGLES, group->elements_length * 3, GL_UNSIGNED_SHORT, BUFFER_OFFSET(quads.getOffset())));
+        glObjectStore.counters.drawCalls++;
         vertex_index += group->vertex_length * icon.vertices.itemSize;
-        elements_index += group->elements_length * icon.triangles.itemSize;
     }
 }
 
-void SymbolBucket::drawIcons(IconShader& shader, gl::GLObjectStore& glObjectStore) {
+void SymbolBucket::drawIcons(IconShader& shader, QuadElementsBuffer& quads, gl::GLObjectStore& glObjectStore) {
     GLbyte *vertex_index = BUFFER_OFFSET_0;
-    GLbyte *elements_index = BUFFER_OFFSET_0;
     auto& icon = renderData->icon;
     for (auto &group : icon.groups) {
         assert(group);
-        group->array[1].bind(shader, icon.vertices, icon.triangles, vertex_index, glObjectStore);
-        MBGL_CHECK_ERROR(glDrawElements(GL_TRIANGLES, group->elements_length * 3, GL_UNSIGNED_SHORT, elements_index));
+        group->array[1].bind(shader, icon.vertices, quads, vertex_index, glObjectStore);
+        MBGL_CHECK_ERROR(glDrawElements(GL_TRIANGLES, group->elements_length * 3, GL_UNSIGNED_SHORT, BUFFER_OFFSET(quads.getOffset())));
+        glObjectStore.counters.drawCalls++;
         vertex_index += group->vertex_length * icon.vertices.itemSize;
-        elements_index += group->elements_length * icon.triangles.itemSize;
     }
 }
 
@@ -621,6 +665,7 @@ void SymbolBucket::drawCollisionBoxes(CollisionBoxShader& shader, gl::GLObjectSt
     for (auto &group : collisionBox.groups) {
         group->array[0].bind(shader, collisionBox.vertices, vertex_index, glObjectStore);
         MBGL_CHECK_ERROR(glDrawArrays(GL_LINES, 0, group->vertex_length));
+        glObjectStore.counters.drawCalls++;
     }
 }
 } // namespace mbgl
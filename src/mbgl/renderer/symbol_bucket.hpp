@@ -13,7 +13,7 @@
 #include <mbgl/text/collision_feature.hpp>
 #include <mbgl/text/shaping.hpp>
 #include <mbgl/text/quads.hpp>
-#include <mbgl/style/filter_expression.hpp>
+#include <mbgl/style/compiled_filter.hpp>
 #include <mbgl/layer/symbol_layer.hpp>
 
 #include <memory>
@@ -82,13 +82,13 @@ public:
                      GlyphAtlas&,
                      GlyphStore&);
 
-    void drawGlyphs(SDFShader&, gl::GLObjectStore&);
-    void drawIcons(SDFShader&, gl::GLObjectStore&);
-    void drawIcons(IconShader&, gl::GLObjectStore&);
+    void drawGlyphs(SDFShader&, QuadElementsBuffer&, gl::GLObjectStore&);
+    void drawIcons(SDFShader&, QuadElementsBuffer&, gl::GLObjectStore&);
+    void drawIcons(IconShader&, QuadElementsBuffer&, gl::GLObjectStore&);
     void drawCollisionBoxes(CollisionBoxShader&, gl::GLObjectStore&);
 
     void parseFeatures(const GeometryTileLayer&,
-                       const FilterExpression&);
+                       const CompiledFilter&);
     bool needsDependencies(GlyphStore&, SpriteStore&);
     void placeFeatures(CollisionTile&) override;
 
@@ -127,14 +127,13 @@ private:
 
     struct SymbolRenderData {
         struct TextBuffer {
+            // Drawn with the painter's shared QuadElementsBuffer.
             TextVertexBuffer vertices;
-            TriangleElementsBuffer triangles;
             std::vector<std::unique_ptr<TextElementGroup>> groups;
         } text;
 
         struct IconBuffer {
             IconVertexBuffer vertices;
-            TriangleElementsBuffer triangles;
             std::vector<std::unique_ptr<IconElementGroup>> groups;
         } icon;
 
@@ -0,0 +1,5 @@
+varying vec4 v_color;
+
+void main() {
+    gl_FragColor = v_color;
+}
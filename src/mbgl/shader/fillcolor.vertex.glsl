@@ -0,0 +1,12 @@
+attribute vec2 a_pos;
+attribute vec4 a_color;
+
+uniform mat4 u_matrix;
+uniform float u_opacity;
+
+varying vec4 v_color;
+
+void main() {
+    gl_Position = u_matrix * vec4(a_pos, 0, 1);
+    v_color = a_color * u_opacity;
+}
@@ -0,0 +1,21 @@
+#include <mbgl/shader/fillcolor_shader.hpp>
+#include <mbgl/shader/fillcolor.vertex.hpp>
+#include <mbgl/shader/fillcolor.fragment.hpp>
+#include <mbgl/gl/gl.hpp>
+
+using namespace mbgl;
+
+FillColorShader::FillColorShader(gl::GLObjectStore& glObjectStore)
+    : Shader("fillcolor", shaders::fillcolor::vertex, shaders::fillcolor::fragment, glObjectStore) {
+    a_color = MBGL_CHECK_ERROR(glGetAttribLocation(getID(), "a_color"));
+}
+
+void FillColorShader::bind(GLbyte* offset) {
+    const GLsizei stride = 8;
+
+    MBGL_CHECK_ERROR(glEnableVertexAttribArray(a_pos));
+    MBGL_CHECK_ERROR(glVertexAttribPointer(a_pos, 2, GL_SHORT, false, stride, offset + 0));
+
+    MBGL_CHECK_ERROR(glEnableVertexAttribArray(a_color));
+    MBGL_CHECK_ERROR(glVertexAttribPointer(a_color, 4, GL_UNSIGNED_BYTE, true, stride, offset + 4));
+}
@@ -0,0 +1,25 @@
+#ifndef MBGL_SHADER_SHADER_FILLCOLOR
+#define MBGL_SHADER_SHADER_FILLCOLOR
+
+#include <mbgl/shader/shader.hpp>
+#include <mbgl/shader/uniform.hpp>
+
+namespace mbgl {
+
+// Draws fills with a color stored in each vertex.
+class FillColorShader : public Shader {
+public:
+    FillColorShader(gl::GLObjectStore&);
+
+    void bind(GLbyte *offset) final;
+
+    UniformMatrix<4>                u_matrix   = {"u_matrix",  *this};
+    Uniform<GLfloat>                u_opacity  = {"u_opacity", *this};
+
+protected:
+    GLint a_color = -1;
+};
+
+} // namespace mbgl
+
+#endif
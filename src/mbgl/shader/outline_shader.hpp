@@ -15,6 +15,9 @@ public:
     UniformMatrix<4>                u_matrix = {"u_matrix", *this};
     Uniform<std::array<GLfloat, 4>> u_color  = {"u_color",  *this};
     Uniform<std::array<GLfloat, 2>> u_world  = {"u_world",  *this};
+
+    // Byte distance between the positions in the bound buffer; 0 if they are tightly packed.
+    GLsizei stride = 0;
 };
 
 } // namespace mbgl
@@ -24,6 +24,9 @@ public:
     Uniform<std::array<GLfloat, 2>> u_patternscale_b  = {"u_patternscale_b",  *this};
     Uniform<std::array<GLfloat, 2>> u_offset_a        = {"u_offset_a",        *this};
     Uniform<std::array<GLfloat, 2>> u_offset_b        = {"u_offset_b",        *this};
+
+    // Byte distance between the positions in the bound buffer; 0 if they are tightly packed.
+    GLsizei stride = 0;
 };
 
 } // namespace mbgl
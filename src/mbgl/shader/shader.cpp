@@ -1,5 +1,6 @@
 #include <mbgl/shader/shader.hpp>
 #include <mbgl/gl/gl.hpp>
+#include <mbgl/gl/program_cache.hpp>
 #include <mbgl/util/stopwatch.hpp>
 #include <mbgl/util/exception.hpp>
 #include <mbgl/platform/log.hpp>
@@ -14,11 +15,26 @@
 namespace mbgl {
 
 Shader::Shader(const char *name_, const GLchar *vertSource, const GLchar *fragSource, gl::GLObjectStore& glObjectStore)
-    : name(name_)
+    : name(name_),
+      objectStore(glObjectStore)
 {
     util::stopwatch stopwatch("shader compilation", Event::Shader);
 
     program.create(glObjectStore);
+
+    gl::ProgramCache* cache = glObjectStore.getProgramCache();
+    if (!cache || !cache->load(program.getID(), name, vertSource, fragSource)) {
+        compileProgram(vertSource, fragSource, glObjectStore, cache);
+        if (cache) {
+            cache->save(program.getID(), name, vertSource, fragSource);
+        }
+    }
+
+    a_pos = MBGL_CHECK_ERROR(glGetAttribLocation(program.getID(), "a_pos"));
+}
+
+void Shader::compileProgram(const GLchar *vertSource, const GLchar *fragSource,
+                            gl::GLObjectStore& glObjectStore, gl::ProgramCache* cache) {
     vertexShader.create(glObjectStore);
     if (!compileShader(vertexShader, &vertSource)) {
         Log::Error(Event::Shader, "Vertex shader %s failed to compile: %s", name, vertSource);
@@ -31,6 +47,10 @@ Shader::Shader(const char *name_, const GLchar *vertSource, const GLchar *fragSo
         throw util::ShaderException(std::string { "Fragment shader " } + name + " failed to compile");
     }
 
+    if (cache) {
+        cache->prepare(program.getID());
+    }
+
     // Attach shaders
     MBGL_CHECK_ERROR(glAttachShader(program.getID(), vertexShader.getID()));
     MBGL_CHECK_ERROR(glAttachShader(program.getID(), fragmentShader.getID()));
@@ -52,8 +72,6 @@ Shader::Shader(const char *name_, const GLchar *vertSource, const GLchar *fragSo
             throw util::ShaderException(std::string { "Program " } + name + " failed to link: " + log.get());
         }
     }
-
-    a_pos = MBGL_CHECK_ERROR(glGetAttribLocation(program.getID(), "a_pos"));
 }
 
 bool Shader::compileShader(gl::ShaderHolder& shader, const GLchar *source[]) {
@@ -86,7 +104,8 @@ bool Shader::compileShader(gl::ShaderHolder& shader, const GLchar *source[]) {
 }
 
 Shader::~Shader() {
-    if (program) {
+    // Programs linked from a cached binary don't have any shaders attached.
+    if (program && vertexShader) {
         MBGL_CHECK_ERROR(glDetachShader(program.getID(), vertexShader.getID()));
         MBGL_CHECK_ERROR(glDetachShader(program.getID(), fragmentShader.getID()));
     }
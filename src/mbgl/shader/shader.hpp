@@ -5,8 +5,14 @@
 #include <mbgl/gl/gl_object_store.hpp>
 #include <mbgl/util/noncopyable.hpp>
 
+#include <memory>
+
 namespace mbgl {
 
+namespace gl {
+class ProgramCache;
+}
+
 class Shader : private util::noncopyable {
 public:
     Shader(const GLchar *name, const GLchar *vertex, const GLchar *fragment, gl::GLObjectStore&);
@@ -20,17 +26,46 @@ public:
 
     virtual void bind(GLbyte *offset) = 0;
 
+    gl::GLObjectStore& getObjectStore() const {
+        return objectStore;
+    }
+
 protected:
     GLint a_pos = -1;
 
 private:
+    void compileProgram(const GLchar *vertex, const GLchar *fragment, gl::GLObjectStore&, gl::ProgramCache*);
     bool compileShader(gl::ShaderHolder&, const GLchar *source[]);
 
+    gl::GLObjectStore& objectStore;
     gl::ProgramHolder program;
     gl::ShaderHolder vertexShader = { GL_VERTEX_SHADER };
     gl::ShaderHolder fragmentShader = { GL_FRAGMENT_SHADER };
 };
 
+// Compiles the shader the first time it is used, so that a map only compiles the shaders
+// its style actually needs.
+template <class T>
+class LazyShader : private util::noncopyable {
+public:
+    explicit LazyShader(gl::GLObjectStore& glObjectStore_) : glObjectStore(glObjectStore_) {}
+
+    T& operator*() {
+        if (!shader) {
+            shader = std::make_unique<T>(glObjectStore);
+        }
+        return *shader;
+    }
+
+    T* operator->() {
+        return &**this;
+    }
+
+private:
+    gl::GLObjectStore& glObjectStore;
+    std::unique_ptr<T> shader;
+};
+
 } // namespace mbgl
 
 #endif
@@ -11,7 +11,8 @@ namespace mbgl {
 template <typename T>
 class Uniform {
 public:
-    Uniform(const GLchar* name, const Shader& shader) : current() {
+    Uniform(const GLchar* name, const Shader& shader)
+        : current(), counters(shader.getObjectStore().counters) {
          location = MBGL_CHECK_ERROR(glGetUniformLocation(shader.getID(), name));
     }
 
@@ -19,6 +20,7 @@ public:
         if (current != t) {
             current = t;
             bind(t);
+            counters.uniformUploads++;
         }
     }
 
@@ -27,6 +29,7 @@ private:
 
     T current;
     GLint location;
+    RenderCounters& counters;
 };
 
 template <size_t C, size_t R = C>
@@ -34,7 +37,8 @@ class UniformMatrix {
 public:
     typedef std::array<float, C*R> T;
 
-    UniformMatrix(const GLchar* name, const Shader& shader) : current() {
+    UniformMatrix(const GLchar* name, const Shader& shader)
+        : current(), counters(shader.getObjectStore().counters) {
         location = MBGL_CHECK_ERROR(glGetUniformLocation(shader.getID(), name));
     }
 
@@ -48,6 +52,7 @@ public:
         }
         if (dirty) {
             bind(current);
+            counters.uniformUploads++;
         }
     }
 
@@ -56,6 +61,7 @@ private:
 
     T current;
     GLint location;
+    RenderCounters& counters;
 };
 
 } // namespace mbgl
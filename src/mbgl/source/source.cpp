@@ -199,6 +199,11 @@ TileData::State Source::hasTile(const TileID& tileID) {
     return TileData::State::invalid;
 }
 
+bool Source::isUploaded(const TileID& tileID) const {
+    auto it = tiles.find(tileID);
+    return it != tiles.end() && it->second->data && it->second->data->uploaded;
+}
+
 bool Source::handlePartialTile(const TileID& tileID) {
     auto it = tileDataMap.find(tileID.normalized());
     if (it == tileDataMap.end()) {
@@ -388,7 +393,11 @@ bool Source::update(const StyleUpdateParameters& parameters) {
             break;
         }
 
-        if (!TileData::isReadyState(state)) {
+        // Tiles that the painter hasn't uploaded yet aren't drawn either, so keep covering
+        // them until they are. Still images upload all tiles at once.
+        const bool uploaded = parameters.mode == MapMode::Still || isUploaded(tileID);
+
+        if (!TileData::isReadyState(state) || !uploaded) {
             // The tile we require is not yet loaded. Try to find a parent or
             // child tile that we already have.
 
@@ -451,6 +460,20 @@ bool Source::update(const StyleUpdateParameters& parameters) {
 
     updateTilePtrs();
 
+    // Parent and child tiles that only stand in for the ideal ones may still be waiting for
+    // data, e.g. after it expired. Let the requests for the ideal tiles go first.
+    // World copies share their data, so it is ideal if any of its tiles is.
+    std::set<const TileData*> idealData;
+    for (const auto& tilePtr : tilePtrs) {
+        if (std::find(required.begin(), required.end(), tilePtr->id) != required.end()) {
+            idealData.insert(tilePtr->data.get());
+        }
+    }
+    for (auto& tilePtr : tilePtrs) {
+        tilePtr->data->setPriority(idealData.count(tilePtr->data.get()) ? Resource::Priority::Regular
+                                                                        : Resource::Priority::Low);
+    }
+
     for (auto& tilePtr : tilePtrs) {
         tilePtr->data->redoPlacement(
             { parameters.transformState.getAngle(), parameters.transformState.getPitch(), parameters.debugOptions & MapDebugOptions::Collision },
@@ -507,6 +530,45 @@ void Source::tileLoadingCallback(const TileID& tileID,
     observer->onTileLoaded(*this, tileID, isNewTile);
 }
 
+SourceProfile Source::getProfile() const {
+    SourceProfile profile;
+    profile.id = id;
+
+    for (const auto& pair : tiles) {
+        const TileData* data = pair.second->data.get();
+        if (!data) {
+            profile.loading++;
+            continue;
+        }
+
+        switch (data->getState()) {
+        case TileData::State::initial:
+        case TileData::State::loading:
+            profile.loading++;
+            break;
+        case TileData::State::loaded:
+            profile.parsing++;
+            break;
+        case TileData::State::partial:
+        case TileData::State::parsed:
+            if (!data->uploaded) {
+                profile.pendingUpload++;
+            } else if (data->getState() == TileData::State::partial) {
+                profile.partial++;
+            } else {
+                profile.parsed++;
+            }
+            break;
+        case TileData::State::invalid:
+        case TileData::State::obsolete:
+            profile.invalid++;
+            break;
+        }
+    }
+
+    return profile;
+}
+
 void Source::dumpDebugLogs() const {
     Log::Info(Event::General, "Source::id: %s", id.c_str());
     Log::Info(Event::General, "Source::loaded: %d", loaded);
@@ -4,6 +4,7 @@
 #include <mbgl/tile/tile_data.hpp>
 #include <mbgl/tile/tile_cache.hpp>
 #include <mbgl/source/source_info.hpp>
+#include <mbgl/map/frame_profile.hpp>
 
 #include <mbgl/util/mat4.hpp>
 #include <mbgl/util/rapidjson.hpp>
@@ -76,6 +77,9 @@ public:
     void setObserver(Observer* observer);
     void dumpDebugLogs() const;
 
+    // Counts the tiles of this source by state.
+    SourceProfile getProfile() const;
+
     const SourceType type;
     const std::string id;
     const std::string url;
@@ -92,6 +96,7 @@ private:
 
     TileData::State addTile(const TileID&, const StyleUpdateParameters&);
     TileData::State hasTile(const TileID&);
+    bool isUploaded(const TileID&) const;
     void updateTilePtrs();
 
 private:
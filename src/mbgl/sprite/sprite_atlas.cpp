@@ -188,6 +188,7 @@ void SpriteAtlas::bind(bool linear, gl::GLObjectStore& glObjectStore) {
     if (!texture) {
         texture.create(glObjectStore);
         MBGL_CHECK_ERROR(glBindTexture(GL_TEXTURE_2D, texture.getID()));
+        glObjectStore.counters.textureBinds++;
 #ifndef GL_ES_VERSION_2_0
         MBGL_CHECK_ERROR(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0));
 #endif
@@ -198,6 +199,7 @@ void SpriteAtlas::bind(bool linear, gl::GLObjectStore& glObjectStore) {
         fullUploadRequired = true;
     } else {
         MBGL_CHECK_ERROR(glBindTexture(GL_TEXTURE_2D, texture.getID()));
+        glObjectStore.counters.textureBinds++;
     }
 
     GLuint filter_val = linear ? GL_LINEAR : GL_NEAREST;
@@ -222,6 +224,7 @@ void SpriteAtlas::bind(bool linear, gl::GLObjectStore& glObjectStore) {
                 GL_UNSIGNED_BYTE, // GLenum type
                 data.get() // const GLvoid * data
             ));
+            glObjectStore.counters.bytesUploaded += pixelWidth * pixelHeight * 4;
             fullUploadRequired = false;
         } else {
             MBGL_CHECK_ERROR(glTexSubImage2D(
@@ -235,6 +238,7 @@ void SpriteAtlas::bind(bool linear, gl::GLObjectStore& glObjectStore) {
                 GL_UNSIGNED_BYTE, // GLenum type
                 data.get() // const GLvoid *pixels
             ));
+            glObjectStore.counters.bytesUploaded += pixelWidth * pixelHeight * 4;
         }
 
         dirty = false;
@@ -0,0 +1,32 @@
+#ifndef MBGL_STORAGE_MBTILES_FILE_SOURCE
+#define MBGL_STORAGE_MBTILES_FILE_SOURCE
+
+#include <mbgl/storage/file_source.hpp>
+
+namespace mbgl {
+
+namespace util {
+template <typename T> class Thread;
+} // namespace util
+
+// Serves resources from read-only MBTiles archives, addressed with URLs of the form
+// mbtiles:///path/to/archive.mbtiles. Tile requests are answered from the `tiles`
+// table; source requests are answered with TileJSON generated from the `metadata`
+// table. Archives are opened once and read through SQLite's memory-mapped I/O.
+class MBTilesFileSource : public FileSource {
+public:
+    MBTilesFileSource();
+    ~MBTilesFileSource() override;
+
+    std::unique_ptr<AsyncRequest> request(const Resource&, Callback) override;
+
+    static bool acceptsURL(const std::string&);
+
+private:
+    class Impl;
+    std::unique_ptr<util::Thread<Impl>> thread;
+};
+
+} // namespace mbgl
+
+#endif // MBGL_STORAGE_MBTILES_FILE_SOURCE
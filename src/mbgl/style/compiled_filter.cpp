@@ -0,0 +1,146 @@
+#include <mbgl/style/compiled_filter.hpp>
+
+#include <algorithm>
+
+namespace mbgl {
+
+bool CompiledFilter::ValueSet::contains(const Value& value) const {
+    if (value.is<std::string>()) {
+        return strings.find(value.get<std::string>()) != strings.end();
+    } else if (value.is<bool>()) {
+        return value.get<bool>() ? hasTrue : hasFalse;
+    } else if (value.is<int64_t>()) {
+        return numbers.find(double(value.get<int64_t>())) != numbers.end();
+    } else if (value.is<uint64_t>()) {
+        return numbers.find(double(value.get<uint64_t>())) != numbers.end();
+    } else {
+        return numbers.find(value.get<double>()) != numbers.end();
+    }
+}
+
+namespace {
+
+// Rough relative cost of evaluating an expression, used to order the operands of
+// "any", "all" and "none".
+struct Cost : public mapbox::util::static_visitor<uint32_t> {
+    uint32_t operator()(const NullExpression&) const { return 0; }
+
+    template <class E>
+    uint32_t operator()(const E& e) const { return compare(e.key); }
+
+    uint32_t operator()(const InExpression&) const { return 3; }
+    uint32_t operator()(const NotInExpression&) const { return 3; }
+
+    uint32_t operator()(const AnyExpression& e) const { return group(e.expressions); }
+    uint32_t operator()(const AllExpression& e) const { return group(e.expressions); }
+    uint32_t operator()(const NoneExpression& e) const { return group(e.expressions); }
+
+    // The feature type doesn't need a property lookup.
+    static uint32_t compare(const std::string& key) { return key == "$type" ? 1 : 2; }
+
+    uint32_t group(const std::vector<FilterExpression>& expressions) const {
+        uint32_t cost = 1;
+        for (const auto& e : expressions) {
+            cost += mapbox::util::apply_visitor(*this, e);
+        }
+        return cost;
+    }
+};
+
+} // namespace
+
+class CompiledFilter::Compiler : public mapbox::util::static_visitor<void> {
+public:
+    Compiler(CompiledFilter& filter_) : filter(filter_) {}
+
+    void operator()(const NullExpression&) {
+        emit(Op::True);
+    }
+
+    void operator()(const EqualsExpression& e) { compare(Op::Equals, e.key, e.value); }
+    void operator()(const NotEqualsExpression& e) { compare(Op::NotEquals, e.key, e.value); }
+    void operator()(const LessThanExpression& e) { compare(Op::LessThan, e.key, e.value); }
+    void operator()(const LessThanEqualsExpression& e) { compare(Op::LessThanEquals, e.key, e.value); }
+    void operator()(const GreaterThanExpression& e) { compare(Op::GreaterThan, e.key, e.value); }
+    void operator()(const GreaterThanEqualsExpression& e) { compare(Op::GreaterThanEquals, e.key, e.value); }
+
+    void operator()(const InExpression& e) { contains(Op::In, e.key, e.values); }
+    void operator()(const NotInExpression& e) { contains(Op::NotIn, e.key, e.values); }
+
+    void operator()(const AnyExpression& e) { group(Op::Any, e.expressions); }
+    void operator()(const AllExpression& e) { group(Op::All, e.expressions); }
+    void operator()(const NoneExpression& e) { group(Op::None, e.expressions); }
+
+private:
+    uint32_t emit(Op op, uint32_t key = 0, uint32_t operand = 0) {
+        const auto index = uint32_t(filter.program.size());
+        Instruction instruction;
+        instruction.op = op;
+        instruction.key = key;
+        instruction.operand = operand;
+        instruction.end = index + 1;
+        filter.program.push_back(instruction);
+        return index;
+    }
+
+    uint32_t intern(const std::string& key) {
+        auto it = std::find(filter.keys.begin(), filter.keys.end(), key);
+        if (it != filter.keys.end()) {
+            return uint32_t(it - filter.keys.begin());
+        }
+        filter.keys.push_back(key);
+        return uint32_t(filter.keys.size() - 1);
+    }
+
+    void compare(Op op, const std::string& key, const Value& value) {
+        filter.values.push_back(value);
+        emit(op, intern(key), uint32_t(filter.values.size() - 1));
+    }
+
+    void contains(Op op, const std::string& key, const std::vector<Value>& values) {
+        ValueSet set;
+        for (const auto& value : values) {
+            if (value.is<std::string>()) {
+                set.strings.insert(value.get<std::string>());
+            } else if (value.is<bool>()) {
+                (value.get<bool>() ? set.hasTrue : set.hasFalse) = true;
+            } else {
+                set.numbers.insert(toNumber<double>(value));
+            }
+        }
+        filter.sets.push_back(std::move(set));
+        emit(op, intern(key), uint32_t(filter.sets.size() - 1));
+    }
+
+    void group(Op op, const std::vector<FilterExpression>& expressions) {
+        // Evaluation stops at the first operand that decides the result, so run the
+        // cheap ones first.
+        std::vector<std::pair<uint32_t, const FilterExpression*>> operands;
+        for (const auto& e : expressions) {
+            operands.emplace_back(mapbox::util::apply_visitor(Cost(), e), &e);
+        }
+        std::stable_sort(operands.begin(), operands.end(), [] (const auto& a, const auto& b) {
+            return a.first < b.first;
+        });
+
+        const uint32_t index = emit(op);
+        for (const auto& operand : operands) {
+            mapbox::util::apply_visitor(*this, *operand.second);
+        }
+        filter.program[index].end = uint32_t(filter.program.size());
+    }
+
+    CompiledFilter& filter;
+};
+
+CompiledFilter::CompiledFilter() {
+    Compiler compiler(*this);
+    compiler(NullExpression());
+}
+
+CompiledFilter::CompiledFilter(const FilterExpression& expression) {
+    Compiler compiler(*this);
+    mapbox::util::apply_visitor(compiler, expression);
+}
+
+} // namespace mbgl
@@ -0,0 +1,188 @@
+#ifndef MBGL_STYLE_COMPILED_FILTER
+#define MBGL_STYLE_COMPILED_FILTER
+
+#include <mbgl/style/filter_expression.hpp>
+#include <mbgl/style/value_comparison.hpp>
+
+#include <cstdint>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace mbgl {
+
+// A filter expression flattened into a list of instructions. Every key the filter refers to
+// is interned into a slot, so that each feature property is looked up at most once per
+// feature and compared in place, without being copied out of the tile. The operands of "in"
+// and "!in" are stored in hash sets, and the operands of "any", "all" and "none" are ordered
+// so that the cheapest tests run first.
+class CompiledFilter {
+public:
+    // Matches every feature.
+    CompiledFilter();
+    explicit CompiledFilter(const FilterExpression&);
+
+    // Property values looked up for the current feature. Reuse it for all features of a
+    // layer to avoid allocating for every feature.
+    class Scratch {
+    private:
+        friend class CompiledFilter;
+        std::vector<const Value*> values;
+        std::vector<bool> loaded;
+    };
+
+    template <class Extractor>
+    bool evaluate(const Extractor&, Scratch&) const;
+
+    template <class Extractor>
+    bool evaluate(const Extractor& extractor) const {
+        Scratch scratch;
+        return evaluate(extractor, scratch);
+    }
+
+private:
+    enum class Op : uint8_t {
+        True,
+        Equals,
+        NotEquals,
+        LessThan,
+        LessThanEquals,
+        GreaterThan,
+        GreaterThanEquals,
+        In,
+        NotIn,
+        Any,
+        All,
+        None,
+    };
+
+    struct Instruction {
+        Op op;
+        // Key slot of the property that is compared.
+        uint32_t key = 0;
+        // Index into values for comparisons, or into sets for "in" and "!in".
+        uint32_t operand = 0;
+        // Index of the instruction following this one's operands.
+        uint32_t end = 0;
+    };
+
+    // Numbers are stored as doubles, which matches util::relaxed_equal except for integers
+    // beyond 2^53.
+    struct ValueSet {
+        std::unordered_set<std::string> strings;
+        std::unordered_set<double> numbers;
+        bool hasTrue = false;
+        bool hasFalse = false;
+
+        bool contains(const Value&) const;
+    };
+
+    class Compiler;
+
+    template <class Extractor>
+    const Value* lookup(uint32_t key, const Extractor&, Scratch&) const;
+
+    template <class Extractor>
+    bool evaluate(uint32_t index, const Extractor&, Scratch&) const;
+
+    std::vector<Instruction> program;
+    std::vector<std::string> keys;
+    std::vector<Value> values;
+    std::vector<ValueSet> sets;
+};
+
+template <class Extractor>
+bool CompiledFilter::evaluate(const Extractor& extractor, Scratch& scratch) const {
+    scratch.values.resize(keys.size());
+    scratch.loaded.assign(keys.size(), false);
+    return evaluate(0, extractor, scratch);
+}
+
+template <class Extractor>
+const Value* CompiledFilter::lookup(uint32_t key, const Extractor& extractor, Scratch& scratch) const {
+    if (!scratch.loaded[key]) {
+        scratch.values[key] = extractor.findValue(keys[key]);
+        scratch.loaded[key] = true;
+    }
+    return scratch.values[key];
+}
+
+template <class Extractor>
+bool CompiledFilter::evaluate(uint32_t index, const Extractor& extractor, Scratch& scratch) const {
+    const Instruction& instruction = program[index];
+
+    switch (instruction.op) {
+    case Op::True:
+        return true;
+
+    case Op::Equals: {
+        const Value* actual = lookup(instruction.key, extractor, scratch);
+        return actual && util::relaxed_equal(*actual, values[instruction.operand]);
+    }
+
+    case Op::NotEquals: {
+        const Value* actual = lookup(instruction.key, extractor, scratch);
+        return !actual || util::relaxed_not_equal(*actual, values[instruction.operand]);
+    }
+
+    case Op::LessThan: {
+        const Value* actual = lookup(instruction.key, extractor, scratch);
+        return actual && util::relaxed_less(*actual, values[instruction.operand]);
+    }
+
+    case Op::LessThanEquals: {
+        const Value* actual = lookup(instruction.key, extractor, scratch);
+        return actual && util::relaxed_less_equal(*actual, values[instruction.operand]);
+    }
+
+    case Op::GreaterThan: {
+        const Value* actual = lookup(instruction.key, extractor, scratch);
+        return actual && util::relaxed_greater(*actual, values[instruction.operand]);
+    }
+
+    case Op::GreaterThanEquals: {
+        const Value* actual = lookup(instruction.key, extractor, scratch);
+        return actual && util::relaxed_greater_equal(*actual, values[instruction.operand]);
+    }
+
+    case Op::In: {
+        const Value* actual = lookup(instruction.key, extractor, scratch);
+        return actual && sets[instruction.operand].contains(*actual);
+    }
+
+    case Op::NotIn: {
+        const Value* actual = lookup(instruction.key, extractor, scratch);
+        return !actual || !sets[instruction.operand].contains(*actual);
+    }
+
+    case Op::Any:
+        for (uint32_t i = index + 1; i < instruction.end; i = program[i].end) {
+            if (evaluate(i, extractor, scratch)) {
+                return true;
+            }
+        }
+        return false;
+
+    case Op::All:
+        for (uint32_t i = index + 1; i < instruction.end; i = program[i].end) {
+            if (!evaluate(i, extractor, scratch)) {
+                return false;
+            }
+        }
+        return true;
+
+    case Op::None:
+        for (uint32_t i = index + 1; i < instruction.end; i = program[i].end) {
+            if (evaluate(i, extractor, scratch)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    return false;
+}
+
+} // namespace mbgl
+
+#endif
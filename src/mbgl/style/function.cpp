@@ -3,6 +3,7 @@
 #include <mbgl/util/interpolate.hpp>
 #include <mbgl/util/chrono.hpp>
 
+#include <algorithm>
 #include <cmath>
 
 namespace mbgl {
@@ -29,49 +30,39 @@ template <> inline RotationAlignmentType defaultStopsValue() { return {}; };
 
 template <typename T>
 T Function<T>::evaluate(const StyleCalculationParameters& parameters) const {
-    float z = parameters.z;
-    bool smaller = false;
-    float smaller_z = 0.0f;
-    T smaller_val = T();
-    bool larger = false;
-    float larger_z = 0.0f;
-    T larger_val = T();
-
-    for (uint32_t i = 0; i < stops.size(); i++) {
-        float stop_z = stops[i].first;
-        T stop_val = stops[i].second;
-        if (stop_z <= z && (!smaller || smaller_z < stop_z)) {
-            smaller = true;
-            smaller_z = stop_z;
-            smaller_val = stop_val;
-        }
-        if (stop_z >= z && (!larger || larger_z > stop_z)) {
-            larger = true;
-            larger_z = stop_z;
-            larger_val = stop_val;
+    const float z = parameters.z;
+    const auto below = [] (const Stop& stop, float zoom) { return stop.first < zoom; };
+    const auto above = [] (float zoom, const Stop& stop) { return zoom < stop.first; };
+
+    // Of several stops at the same zoom level, the first one wins.
+    const auto larger = std::lower_bound(stops.begin(), stops.end(), z, below);
+
+    if (larger == stops.end()) {
+        if (stops.empty()) {
+            // No stop defined.
+            return defaultStopsValue<T>();
         }
+        return std::lower_bound(stops.begin(), stops.end(), stops.back().first, below)->second;
+    } else if (larger == stops.begin() || !above(z, *larger)) {
+        return larger->second;
     }
 
-    if (smaller && larger) {
-        if (larger_z == smaller_z || larger_val == smaller_val) {
-            return smaller_val;
-        }
-        const float zoomDiff = larger_z - smaller_z;
-        const float zoomProgress = z - smaller_z;
-        if (base == 1.0f) {
-            const float t = zoomProgress / zoomDiff;
-            return util::interpolate(smaller_val, larger_val, t);
-        } else {
-            const float t = (std::pow(base, zoomProgress) - 1) / (std::pow(base, zoomDiff) - 1);
-            return util::interpolate(smaller_val, larger_val, t);
-        }
-    } else if (larger) {
-        return larger_val;
-    } else if (smaller) {
+    const auto smaller = std::lower_bound(stops.begin(), larger, (larger - 1)->first, below);
+
+    const T& smaller_val = smaller->second;
+    const T& larger_val = larger->second;
+    if (larger_val == smaller_val) {
         return smaller_val;
+    }
+
+    const float zoomDiff = larger->first - smaller->first;
+    const float zoomProgress = z - smaller->first;
+    if (base == 1.0f) {
+        const float t = zoomProgress / zoomDiff;
+        return util::interpolate(smaller_val, larger_val, t);
     } else {
-        // No stop defined.
-        return defaultStopsValue<T>();
+        const float t = (std::pow(base, zoomProgress) - 1) / (std::pow(base, zoomDiff) - 1);
+        return util::interpolate(smaller_val, larger_val, t);
     }
 }
 
@@ -94,12 +85,10 @@ template class Function<RotationAlignmentType>;
 
 template <typename T>
 inline size_t getBiggestStopLessThan(const std::vector<std::pair<float, T>>& stops, float z) {
-    for (uint32_t i = 0; i < stops.size(); i++) {
-        if (stops[i].first > z) {
-            return i == 0 ? i : i - 1;
-        }
-    }
-    return stops.size() - 1;
+    const auto it = std::upper_bound(stops.begin(), stops.end(), z, [] (float value, const auto& stop) {
+        return value < stop.first;
+    });
+    return it == stops.begin() ? 0 : (it - stops.begin()) - 1;
 }
 
 template <typename T>
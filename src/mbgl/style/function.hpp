@@ -5,6 +5,7 @@
 #include <mbgl/util/chrono.hpp>
 #include <mbgl/util/optional.hpp>
 
+#include <algorithm>
 #include <vector>
 #include <utility>
 
@@ -12,6 +13,16 @@ namespace mbgl {
 
 class StyleCalculationParameters;
 
+// Orders stops by zoom level so that evaluation can use a binary search. Stops with the
+// same zoom level keep their relative order.
+template <typename Stops>
+Stops sorted(Stops stops) {
+    std::stable_sort(stops.begin(), stops.end(), [] (const auto& a, const auto& b) {
+        return a.first < b.first;
+    });
+    return stops;
+}
+
 template <typename T>
 class Function {
 public:
@@ -23,7 +34,7 @@ public:
         : stops({{ 0, constant }}) {}
 
     explicit Function(const Stops& stops_, float base_)
-        : base(base_), stops(stops_) {}
+        : base(base_), stops(sorted(stops_)) {}
 
     T evaluate(const StyleCalculationParameters&) const;
 
@@ -47,7 +58,7 @@ public:
         : stops({{ 0, constant }}) {}
 
     explicit Function(const Stops& stops_)
-        : stops(stops_) {}
+        : stops(sorted(stops_)) {}
 
     Faded<T> evaluate(const StyleCalculationParameters&) const;
 
@@ -8,14 +8,50 @@
 #include <mbgl/style/style_cascade_parameters.hpp>
 #include <mbgl/style/style_calculation_parameters.hpp>
 #include <mbgl/util/interpolate.hpp>
-#include <mbgl/util/std.hpp>
 #include <mbgl/util/rapidjson.hpp>
 
-#include <map>
+#include <algorithm>
+#include <cassert>
+#include <cstring>
 #include <utility>
+#include <vector>
 
 namespace mbgl {
 
+// Values of a paint property by class, in the order they were added. Layers rarely have
+// more than a few classes, so a linear search is faster than a map.
+template <typename V>
+class ClassValues {
+public:
+    // Like std::map::emplace, doesn't replace an existing value. Returns whether the value
+    // was added.
+    bool emplace(ClassID classID, V value) {
+        if (find(classID)) {
+            return false;
+        }
+        entries.emplace_back(classID, std::move(value));
+        return true;
+    }
+
+    const V* find(ClassID classID) const {
+        for (const auto& entry : entries) {
+            if (entry.first == classID) {
+                return &entry.second;
+            }
+        }
+        return nullptr;
+    }
+
+    void eraseExcept(ClassID classID) {
+        entries.erase(std::remove_if(entries.begin(), entries.end(), [&] (const auto& entry) {
+            return entry.first != classID;
+        }), entries.end());
+    }
+
+private:
+    std::vector<std::pair<ClassID, V>> entries;
+};
+
 template <typename T, typename Result = T>
 class PaintProperty {
 public:
@@ -31,32 +67,45 @@ public:
           transitions(other.transitions) {
     }
 
+    // The cascaded values point into values, so they can't be copied from another property.
+    PaintProperty& operator=(const PaintProperty&) = delete;
+
     void parse(const char* name, const JSValue& layer) {
-        mbgl::util::erase_if(values, [] (const auto& p) { return p.first != ClassID::Fallback; });
+        values.eraseExcept(ClassID::Fallback);
+        cascaded.clear();
 
         std::string transitionName = { name };
         transitionName += "-transition";
 
         for (auto it = layer.MemberBegin(); it != layer.MemberEnd(); ++it) {
-            const std::string paintName { it->name.GetString(), it->name.GetStringLength() };
-            if (paintName.compare(0, 5, "paint") != 0)
+            // Layers are parsed once for every paint property, so avoid copying member names.
+            const char* paintName = it->name.GetString();
+            const auto paintNameLength = it->name.GetStringLength();
+            if (paintNameLength < 5 || std::strncmp(paintName, "paint", 5) != 0)
+                continue;
+
+            bool isClass = paintNameLength >= 6 && paintName[5] == '.';
+            if (isClass && paintNameLength <= 6)
                 continue;
 
-            bool isClass = paintName.compare(0, 6, "paint.") == 0;
-            if (isClass && paintName.length() <= 6)
+            const auto property = it->value.FindMember(name);
+            const auto transition = it->value.FindMember(transitionName.c_str());
+            if (property == it->value.MemberEnd() && transition == it->value.MemberEnd())
                 continue;
 
-            ClassID classID = isClass ? ClassDictionary::Get().lookup(paintName.substr(6)) : ClassID::Default;
+            ClassID classID = isClass
+                ? ClassDictionary::Get().lookup({ paintName + 6, paintNameLength - 6 })
+                : ClassID::Default;
 
-            if (it->value.HasMember(name)) {
-                auto v = parseProperty<Fn>(name, it->value[name]);
+            if (property != it->value.MemberEnd()) {
+                auto v = parseProperty<Fn>(name, property->value);
                 if (v) {
                     values.emplace(classID, *v);
                 }
             }
 
-            if (it->value.HasMember(transitionName.c_str())) {
-                auto v = parseProperty<PropertyTransition>(name, it->value[transitionName.c_str()]);
+            if (transition != it->value.MemberEnd()) {
+                auto v = parseProperty<PropertyTransition>(name, transition->value);
                 if (v) {
                     transitions.emplace(classID, *v);
                 }
@@ -70,72 +119,66 @@ public:
         Duration duration = params.transition.duration.value_or(Duration::zero());
 
         for (const auto classID : params.classes) {
-            if (values.find(classID) == values.end())
+            const Fn* fn = values.find(classID);
+            if (!fn)
                 continue;
 
-            if (overrideTransition && transitions.find(classID) != transitions.end()) {
-                const PropertyTransition& transition = transitions[classID];
-                if (transition.delay) delay = *transition.delay;
-                if (transition.duration) duration = *transition.duration;
+            if (overrideTransition) {
+                if (const PropertyTransition* transition = transitions.find(classID)) {
+                    if (transition->delay) delay = *transition->delay;
+                    if (transition->duration) duration = *transition->duration;
+                }
             }
 
-            cascaded = std::make_unique<CascadedValue>(std::move(cascaded),
-                                                       params.now + delay,
-                                                       params.now + delay + duration,
-                                                       values.at(classID));
+            cascaded.push_back({ params.now + delay, params.now + delay + duration, fn });
 
             break;
         }
 
-        assert(cascaded);
+        assert(!cascaded.empty());
     }
 
     bool calculate(const StyleCalculationParameters& parameters) {
-        assert(cascaded);
-        value = cascaded->calculate(parameters);
-        return cascaded->prior.operator bool();
-    }
-
-    void operator=(const T& v) { values.emplace(ClassID::Default, Fn(v)); }
-    operator T() const { return value; }
+        assert(!cascaded.empty());
 
-    std::map<ClassID, Fn> values;
-    std::map<ClassID, PropertyTransition> transitions;
+        // Once a transition is complete, the values it started from aren't needed anymore.
+        for (auto it = cascaded.end() - 1; it != cascaded.begin(); --it) {
+            if (parameters.now >= it->end) {
+                cascaded.erase(cascaded.begin(), it);
+                break;
+            }
+        }
 
-    struct CascadedValue {
-        CascadedValue(std::unique_ptr<CascadedValue> prior_,
-                      TimePoint begin_,
-                      TimePoint end_,
-                      Fn value_)
-            : prior(std::move(prior_)),
-              begin(begin_),
-              end(end_),
-              value(std::move(value_)) {
+        // Interpolate from the oldest value through each transition that is still running.
+        value = cascaded.front().value->evaluate(parameters);
+        for (auto it = cascaded.begin() + 1; it != cascaded.end(); ++it) {
+            float t = std::chrono::duration<float>(parameters.now - it->begin) / (it->end - it->begin);
+            value = util::interpolate(value, it->value->evaluate(parameters), t);
         }
 
-        Result calculate(const StyleCalculationParameters& parameters) {
-            Result final = value.evaluate(parameters);
-            if (!prior) {
-                // No prior value.
-                return final;
-            } else if (parameters.now >= end) {
-                // Transition from prior value is now complete.
-                prior.reset();
-                return final;
-            } else {
-                // Interpolate between recursively-calculated prior value and final.
-                float t = std::chrono::duration<float>(parameters.now - begin) / (end - begin);
-                return util::interpolate(prior->calculate(parameters), final, t);
-            }
+        return cascaded.size() > 1;
+    }
+
+    void operator=(const T& v) {
+        // Adding a value may move the others, which the cascaded values point to.
+        if (values.emplace(ClassID::Default, Fn(v))) {
+            cascaded.clear();
         }
+    }
+    operator T() const { return value; }
+
+    ClassValues<Fn> values;
+    ClassValues<PropertyTransition> transitions;
 
-        std::unique_ptr<CascadedValue> prior;
+    // A value that was cascaded, transitioning from the one before it. The first value has
+    // no transition. The storage is reused from one cascade to the next.
+    struct CascadedValue {
         TimePoint begin;
         TimePoint end;
-        Fn value;
+        const Fn* value;
     };
 
-    std::unique_ptr<CascadedValue> cascaded;
+    std::vector<CascadedValue> cascaded;
 
     Result value;
 };
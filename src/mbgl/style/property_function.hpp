@@ -0,0 +1,87 @@
+#ifndef MBGL_STYLE_PROPERTY_FUNCTION
+#define MBGL_STYLE_PROPERTY_FUNCTION
+
+#include <mbgl/style/value.hpp>
+
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace mbgl {
+
+// A paint value that depends on a feature property instead of the zoom level. It is
+// evaluated once per feature when the bucket is built, and the result is stored in the
+// vertices. The stops are categories: the first stop whose value equals the feature's
+// property wins. Features without a matching stop get the default value.
+template <typename T>
+class PropertyFunction {
+public:
+    using Stop = std::pair<Value, T>;
+    using Stops = std::vector<Stop>;
+
+    PropertyFunction(const std::string& property_, const Stops& stops_, const T& defaultValue_)
+        : property(property_), stops(stops_), defaultValue(defaultValue_) {
+        // Index the stops the way util::relaxed_equal compares values: numbers by their
+        // double value, and strings and booleans only with their own kind. emplace() keeps
+        // the first stop of each value.
+        for (const auto& stop : stops) {
+            const Value& key = stop.first;
+            if (key.is<std::string>()) {
+                stringStops.emplace(key.get<std::string>(), stop.second);
+            } else if (key.is<bool>()) {
+                boolStops.emplace(key.get<bool>(), stop.second);
+            } else {
+                numberStops.emplace(toDouble(key), stop.second);
+            }
+        }
+    }
+
+    template <class Feature>
+    T evaluate(const Feature& feature) const {
+        const Value* value = feature.findValue(property);
+        if (!value) {
+            return defaultValue;
+        }
+        if (value->is<std::string>()) {
+            return find(stringStops, value->get<std::string>());
+        } else if (value->is<bool>()) {
+            return find(boolStops, value->get<bool>());
+        } else {
+            return find(numberStops, toDouble(*value));
+        }
+    }
+
+    const std::string& getProperty() const { return property; }
+    const Stops& getStops() const { return stops; }
+    const T& getDefault() const { return defaultValue; }
+
+private:
+    static double toDouble(const Value& value) {
+        if (value.is<int64_t>()) {
+            return double(value.get<int64_t>());
+        } else if (value.is<uint64_t>()) {
+            return double(value.get<uint64_t>());
+        } else {
+            return value.get<double>();
+        }
+    }
+
+    template <typename Map, typename Key>
+    const T& find(const Map& map, const Key& key) const {
+        const auto it = map.find(key);
+        return it != map.end() ? it->second : defaultValue;
+    }
+
+    std::string property;
+    Stops stops;
+    T defaultValue;
+
+    std::unordered_map<std::string, T> stringStops;
+    std::unordered_map<double, T> numberStops;
+    std::unordered_map<bool, T> boolStops;
+};
+
+} // namespace mbgl
+
+#endif
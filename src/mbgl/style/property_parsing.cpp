@@ -1,11 +1,13 @@
 #include <mbgl/style/property_parsing.hpp>
 #include <mbgl/style/property_transition.hpp>
 #include <mbgl/style/function.hpp>
+#include <mbgl/style/property_function.hpp>
 
 #include <mbgl/platform/log.hpp>
 
 #include <csscolorparser/csscolorparser.hpp>
 
+#include <cstring>
 #include <vector>
 
 namespace mbgl {
@@ -269,6 +271,11 @@ optional<std::vector<std::pair<float, T>>> parseStops(const char* name, const JS
     return stops;
 }
 
+// Paint properties that can be evaluated per feature when the bucket is built.
+static bool supportsPropertyFunction(const char* name) {
+    return std::strcmp(name, "fill-color") == 0;
+}
+
 template <typename T>
 optional<Function<T>> parseFunction(const char* name, const JSValue& value) {
     if (!value.IsObject()) {
@@ -279,6 +286,15 @@ optional<Function<T>> parseFunction(const char* name, const JSValue& value) {
         return { Function<T>(*constant) };
     }
 
+    if (value.HasMember("property")) {
+        // Layers that support property functions parse them separately and use the
+        // property's default value for everything that is evaluated per zoom level.
+        if (!supportsPropertyFunction(name)) {
+            Log::Warning(Event::ParseStyle, "'%s' doesn't support property functions", name);
+        }
+        return {};
+    }
+
     if (!value.HasMember("stops")) {
         Log::Warning(Event::ParseStyle, "function must specify a function type");
         return {};
@@ -362,6 +378,69 @@ template<> optional<Function<Color>> parseProperty(const char* name, const JSVal
     return parseFunction<Color>(name, value);
 }
 
+// --- PropertyFunction ---
+
+template <typename T>
+optional<PropertyFunction<T>> parsePropertyFunction(const char* name, const JSValue& value, const T& fallback) {
+    if (!value.IsObject() || !value.HasMember("property")) {
+        return {};
+    }
+
+    const JSValue& property = value["property"];
+    if (!property.IsString()) {
+        Log::Warning(Event::ParseStyle, "property function of '%s' must name a string property", name);
+        return {};
+    }
+
+    if (!value.HasMember("stops") || !value["stops"].IsArray()) {
+        Log::Warning(Event::ParseStyle, "property function of '%s' must specify a stops array", name);
+        return {};
+    }
+
+    const JSValue& stopsValue = value["stops"];
+    typename PropertyFunction<T>::Stops stops;
+
+    for (rapidjson::SizeType i = 0; i < stopsValue.Size(); ++i) {
+        const JSValue& stop = stopsValue[i];
+
+        if (!stop.IsArray() || stop.Size() != 2) {
+            Log::Warning(Event::ParseStyle, "stop must have property value and value specification");
+            return {};
+        }
+
+        const JSValue& key = stop[rapidjson::SizeType(0)];
+        if (!key.IsString() && !key.IsNumber() && !key.IsBool()) {
+            Log::Warning(Event::ParseStyle, "property value in stop must be a string, number or boolean");
+            return {};
+        }
+
+        optional<T> v = parseProperty<T>(name, stop[rapidjson::SizeType(1)]);
+        if (!v) {
+            return {};
+        }
+
+        stops.emplace_back(parseValue(key), *v);
+    }
+
+    // Without a default, features that don't match any stop get the property's own default.
+    T defaultValue = fallback;
+    if (value.HasMember("default")) {
+        optional<T> v = parseProperty<T>(name, value["default"]);
+        if (!v) {
+            return {};
+        }
+        defaultValue = *v;
+    }
+
+    return PropertyFunction<T>(property.GetString(), stops, defaultValue);
+}
+
+template <> optional<PropertyFunction<Color>> parseProperty(const char* name, const JSValue& value) {
+    // fill-color is the only property that supports property functions; its default is
+    // opaque black. A transparent fallback would make the whole layer translucent.
+    return parsePropertyFunction<Color>(name, value, {{ 0, 0, 0, 1 }});
+}
+
 template <typename T>
 optional<Function<Faded<T>>> parseFadedFunction(const JSValue& value) {
     if (!value.HasMember("stops")) {
@@ -72,7 +72,11 @@ Style::Style(MapData& data_, FileSource& fileSource_)
 
 void Style::setJSON(const std::string& json, const std::string&) {
     sources.clear();
+    sourceIndex.clear();
     layers.clear();
+    layerIndex.clear();
+    layerSnapshot.reset();
+    renderOrderValid = false;
     classes.clear();
 
     StyleParser parser;
@@ -103,27 +107,38 @@ Style::~Style() {
 
 void Style::addSource(std::unique_ptr<Source> source) {
     source->setObserver(this);
+    sourceIndex.emplace(source->id, source.get());
     sources.emplace_back(std::move(source));
+    renderOrderValid = false;
 }
 
-std::vector<std::unique_ptr<StyleLayer>> Style::getLayers() const {
-    std::vector<std::unique_ptr<StyleLayer>> result;
-    result.reserve(layers.size());
-    for (const auto& layer : layers) {
-        result.push_back(layer->clone());
+StyleLayerSnapshot Style::getLayerSnapshot() const {
+    // The layers themselves can't be shared with the workers, since cascading and recalculating
+    // them modifies their properties.
+    if (!layerSnapshot) {
+        auto snapshot = std::make_shared<std::vector<std::unique_ptr<StyleLayer>>>();
+        snapshot->reserve(layers.size());
+        for (const auto& layer : layers) {
+            snapshot->push_back(layer->clone());
+        }
+        layerSnapshot = std::move(snapshot);
     }
-    return result;
+    return layerSnapshot;
 }
 
 std::vector<std::unique_ptr<StyleLayer>>::const_iterator Style::findLayer(const std::string& id) const {
-    return std::find_if(layers.begin(), layers.end(), [&](const auto& layer) {
-        return layer->id == id;
+    StyleLayer* layer = getLayer(id);
+    if (!layer) {
+        return layers.end();
+    }
+    return std::find_if(layers.begin(), layers.end(), [&](const auto& l) {
+        return l.get() == layer;
     });
 }
 
 StyleLayer* Style::getLayer(const std::string& id) const {
-    auto it = findLayer(id);
-    return it != layers.end() ? it->get() : nullptr;
+    const auto it = layerIndex.find(id);
+    return it != layerIndex.end() ? it->second : nullptr;
 }
 
 void Style::addLayer(std::unique_ptr<StyleLayer> layer, optional<std::string> before) {
@@ -137,7 +152,10 @@ void Style::addLayer(std::unique_ptr<StyleLayer> layer, optional<std::string> be
         customLayer->initialize();
     }
 
+    layerIndex.emplace(layer->id, layer.get());
     layers.emplace(before ? findLayer(*before) : layers.end(), std::move(layer));
+    layerSnapshot.reset();
+    renderOrderValid = false;
 }
 
 void Style::removeLayer(const std::string& id) {
@@ -145,6 +163,17 @@ void Style::removeLayer(const std::string& id) {
     if (it == layers.end())
         throw std::runtime_error("no such layer");
     layers.erase(it);
+    layerSnapshot.reset();
+    renderOrderValid = false;
+
+    // Another layer with the same ID may have been shadowed by the removed one.
+    layerIndex.erase(id);
+    it = std::find_if(layers.begin(), layers.end(), [&](const auto& layer) {
+        return layer->id == id;
+    });
+    if (it != layers.end()) {
+        layerIndex.emplace(id, it->get());
+    }
 }
 
 void Style::update(const TransformState& transform, const TimePoint& timePoint,
@@ -197,6 +226,7 @@ void Style::cascade(const TimePoint& timePoint) {
 
     for (const auto& layer : layers) {
         layer->cascade(parameters);
+        layer->invalidateCalculation();
     }
 }
 
@@ -216,7 +246,7 @@ void Style::recalculate(float z, const TimePoint& timePoint) {
 
     hasPendingTransitions = false;
     for (const auto& layer : layers) {
-        hasPendingTransitions |= layer->recalculate(parameters);
+        hasPendingTransitions |= layer->recalculateIfNeeded(parameters);
 
         Source* source = getSource(layer->source);
         if (source && layer->needsRendering()) {
@@ -229,11 +259,8 @@ void Style::recalculate(float z, const TimePoint& timePoint) {
 }
 
 Source* Style::getSource(const std::string& id) const {
-    const auto it = std::find_if(sources.begin(), sources.end(), [&](const auto& source) {
-        return source->id == id;
-    });
-
-    return it != sources.end() ? it->get() : nullptr;
+    const auto it = sourceIndex.find(id);
+    return it != sourceIndex.end() ? it->second : nullptr;
 }
 
 bool Style::hasTransitions() const {
@@ -265,27 +292,50 @@ RenderData Style::getRenderData() const {
         }
     }
 
-    for (const auto& layer : layers) {
-        if (layer->visibility == VisibilityType::None)
-            continue;
+    // A solid background at the bottom is drawn with glClear() instead of a quad.
+    const BackgroundLayer* solidBackground = layers.empty() ? nullptr : layers[0]->as<BackgroundLayer>();
+    if (solidBackground && (solidBackground->visibility == VisibilityType::None ||
+                            !solidBackground->paint.pattern.value.from.empty())) {
+        solidBackground = nullptr;
+    }
 
-        if (const BackgroundLayer* background = layer->as<BackgroundLayer>()) {
-            if (layer.get() == layers[0].get() && background->paint.pattern.value.from.empty()) {
-                // This is a solid background. We can use glClear().
-                result.backgroundColor = background->paint.color;
-                result.backgroundColor[0] *= background->paint.opacity;
-                result.backgroundColor[1] *= background->paint.opacity;
-                result.backgroundColor[2] *= background->paint.opacity;
-                result.backgroundColor[3] *= background->paint.opacity;
-            } else {
-                // This is a textured background, or not the bottommost layer. We need to render it with a quad.
-                result.order.emplace_back(*layer);
-            }
-            continue;
+    if (solidBackground) {
+        result.backgroundColor = solidBackground->paint.color;
+        result.backgroundColor[0] *= solidBackground->paint.opacity;
+        result.backgroundColor[1] *= solidBackground->paint.opacity;
+        result.backgroundColor[2] *= solidBackground->paint.opacity;
+        result.backgroundColor[3] *= solidBackground->paint.opacity;
+    }
+
+    currentTileStates.clear();
+    for (const auto& source : sources) {
+        for (const auto tile : source->getTiles()) {
+            const TileData* data = tile->data.get();
+            currentTileStates.push_back({ tile, data, data && data->isReady(), data ? data->getBucketsVersion() : 0 });
         }
+    }
+
+    if (!renderOrderValid || renderOrderSolidBackground != bool(solidBackground) || currentTileStates != renderTileStates) {
+        renderOrder = std::make_shared<const std::vector<RenderItem>>(getRenderOrder(solidBackground));
+        std::swap(renderTileStates, currentTileStates);
+        renderOrderSolidBackground = solidBackground;
+        renderOrderValid = true;
+    }
+
+    result.order = renderOrder;
+
+    return result;
+}
+
+std::vector<RenderItem> Style::getRenderOrder(const BackgroundLayer* solidBackground) const {
+    std::vector<RenderItem> order;
 
-        if (layer->is<CustomLayer>()) {
-            result.order.emplace_back(*layer);
+    for (const auto& layer : layers) {
+        if (layer->visibility == VisibilityType::None || layer.get() == solidBackground)
+            continue;
+
+        if (layer->is<BackgroundLayer>() || layer->is<CustomLayer>()) {
+            order.emplace_back(*layer);
             continue;
         }
 
@@ -307,7 +357,7 @@ RenderData Style::getRenderData() const {
                 // Look back through the buckets we decided to render to find out whether there is
                 // already a bucket from this layer that is a parent of this tile. Tiles are ordered
                 // by zoom level when we obtain them from getTiles().
-                for (auto it = result.order.rbegin(); it != result.order.rend() && (&it->layer == layer.get()); ++it) {
+                for (auto it = order.rbegin(); it != order.rend() && (&it->layer == layer.get()); ++it) {
                     if (tile->id.isChildOf(it->tile->id)) {
                         skip = true;
                         break;
@@ -320,12 +370,12 @@ RenderData Style::getRenderData() const {
 
             auto bucket = tile->data->getBucket(*layer);
             if (bucket) {
-                result.order.emplace_back(*layer, tile, bucket);
+                order.emplace_back(*layer, tile, bucket);
             }
         }
     }
 
-    return result;
+    return order;
 }
 
 void Style::setSourceTileCacheSize(size_t size) {
@@ -406,6 +456,15 @@ void Style::onSpriteError(std::exception_ptr error) {
     observer->onResourceError(error);
 }
 
+void Style::profile(FrameProfile& profile) const {
+    profile.sources.clear();
+    for (const auto& source : sources) {
+        profile.sources.push_back(source->getProfile());
+    }
+
+    profile.workerQueueDepths = workers.queueDepths();
+}
+
 void Style::dumpDebugLogs() const {
     for (const auto& source : sources) {
         source->dumpDebugLogs();
@@ -14,7 +14,9 @@
 #include <mbgl/util/optional.hpp>
 
 #include <cstdint>
+#include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace mbgl {
@@ -29,6 +31,8 @@ class LineAtlas;
 class StyleLayer;
 class TransformState;
 class Tile;
+class TileData;
+class BackgroundLayer;
 class Bucket;
 
 namespace gl { class TexturePool; }
@@ -48,7 +52,8 @@ struct RenderItem {
 struct RenderData {
     Color backgroundColor = {{ 0, 0, 0, 0 }};
     std::set<Source*> sources;
-    std::vector<RenderItem> order;
+    // Shared with the style, which keeps it until the render order changes.
+    std::shared_ptr<const std::vector<RenderItem>> order;
 };
 
 class Style : public GlyphStore::Observer,
@@ -95,7 +100,9 @@ public:
     Source* getSource(const std::string& id) const;
     void addSource(std::unique_ptr<Source>);
 
-    std::vector<std::unique_ptr<StyleLayer>> getLayers() const;
+    // Returns copies of the layers for parsing tiles. All tiles share the same copies until the
+    // layers are added, removed or replaced.
+    StyleLayerSnapshot getLayerSnapshot() const;
     StyleLayer* getLayer(const std::string& id) const;
     void addLayer(std::unique_ptr<StyleLayer>,
                   optional<std::string> beforeLayerID = {});
@@ -114,6 +121,9 @@ public:
 
     void dumpDebugLogs() const;
 
+    // Fills in the tile counts and worker queue depths of a frame profile.
+    void profile(FrameProfile&) const;
+
     MapData& data;
     FileSource& fileSource;
     std::unique_ptr<GlyphStore> glyphStore;
@@ -125,11 +135,41 @@ public:
 private:
     std::vector<std::unique_ptr<Source>> sources;
     std::vector<std::unique_ptr<StyleLayer>> layers;
+
+    // Sources and layers by ID. If several have the same ID, the first one added wins.
+    std::unordered_map<std::string, Source*> sourceIndex;
+    std::unordered_map<std::string, StyleLayer*> layerIndex;
+
+    // The tiles of all sources, with their readiness and buckets, that renderOrder was built
+    // from. The render order is only rebuilt when they, or the layers, change.
+    struct RenderTileState {
+        const Tile* tile;
+        const TileData* data;
+        bool ready;
+        uint64_t bucketsVersion;
+
+        bool operator==(const RenderTileState& other) const {
+            return tile == other.tile && data == other.data && ready == other.ready &&
+                   bucketsVersion == other.bucketsVersion;
+        }
+    };
+
+    mutable std::shared_ptr<const std::vector<RenderItem>> renderOrder;
+    mutable std::vector<RenderTileState> renderTileStates;
+    // The tile states of the current frame, compared against renderTileStates. Kept to reuse
+    // its storage.
+    mutable std::vector<RenderTileState> currentTileStates;
+    mutable bool renderOrderSolidBackground = false;
+    mutable bool renderOrderValid = false;
+    mutable StyleLayerSnapshot layerSnapshot;
     std::vector<std::string> classes;
     optional<PropertyTransition> transitionProperties;
 
     std::vector<std::unique_ptr<StyleLayer>>::const_iterator findLayer(const std::string& layerID) const;
 
+    // Walks all layers and the tiles of their sources to find the buckets to render.
+    std::vector<RenderItem> getRenderOrder(const BackgroundLayer* solidBackground) const;
+
     // GlyphStore::Observer implementation.
     void onGlyphsLoaded(const std::string& fontStack, const GlyphRange&) override;
     void onGlyphsError(const std::string& fontStack, const GlyphRange&, std::exception_ptr) override;
@@ -3,13 +3,14 @@
 
 namespace mbgl {
 
-void StyleBucketParameters::eachFilteredFeature(const FilterExpression& filter,
+void StyleBucketParameters::eachFilteredFeature(const CompiledFilter& filter,
                                                 std::function<void (const GeometryTileFeature&)> function) {
+    CompiledFilter::Scratch scratch;
     for (std::size_t i = 0; !cancelled() && i < layer.featureCount(); i++) {
         auto feature = layer.getFeature(i);
 
         GeometryTileFeatureExtractor extractor(*feature);
-        if (!evaluate(filter, extractor))
+        if (!filter.evaluate(extractor, scratch))
             continue;
 
         function(*feature);
@@ -1,4 +1,5 @@
 #include <mbgl/style/style_layer.hpp>
+#include <mbgl/style/style_calculation_parameters.hpp>
 
 namespace mbgl {
 
@@ -6,6 +7,26 @@ const std::string& StyleLayer::bucketName() const {
     return ref.empty() ? id : ref;
 }
 
+bool StyleLayer::recalculateIfNeeded(const StyleCalculationParameters& parameters) {
+    if (calculatedZoom && *calculatedZoom == parameters.z) {
+        return false;
+    }
+
+    const bool hasTransitions = recalculate(parameters);
+
+    // Cross-faded properties change over time until the fade after the last integer zoom
+    // level change is complete.
+    const bool fading = parameters.now - parameters.zoomHistory.lastIntegerZoomTime < parameters.defaultFadeDuration;
+
+    if (hasTransitions || fading) {
+        calculatedZoom = {};
+    } else {
+        calculatedZoom = parameters.z;
+    }
+
+    return hasTransitions;
+}
+
 bool StyleLayer::hasRenderPass(RenderPass pass) const {
     return bool(passes & pass);
 }
@@ -2,14 +2,16 @@
 #define MBGL_STYLE_STYLE_LAYER
 
 #include <mbgl/style/types.hpp>
-#include <mbgl/style/filter_expression.hpp>
+#include <mbgl/style/compiled_filter.hpp>
 #include <mbgl/renderer/render_pass.hpp>
 #include <mbgl/util/noncopyable.hpp>
+#include <mbgl/util/optional.hpp>
 #include <mbgl/util/rapidjson.hpp>
 
 #include <memory>
 #include <string>
 #include <limits>
+#include <vector>
 
 namespace mbgl {
 
@@ -52,6 +54,13 @@ public:
     // Returns true if any paint properties have active transitions.
     virtual bool recalculate(const StyleCalculationParameters&) = 0;
 
+    // Like recalculate(), but skips the work if the layer was already calculated for this
+    // zoom level since the last cascade, and no transitions or cross-fades were running.
+    bool recalculateIfNeeded(const StyleCalculationParameters&);
+
+    // Makes the next recalculateIfNeeded() call recalculate. Call after cascading.
+    void invalidateCalculation() { calculatedZoom = {}; }
+
     virtual std::unique_ptr<Bucket> createBucket(StyleBucketParameters&) const = 0;
 
     // Checks whether this layer needs to be rendered in the given render pass.
@@ -65,7 +74,7 @@ public:
     std::string ref;
     std::string source;
     std::string sourceLayer;
-    FilterExpression filter;
+    CompiledFilter filter;
     float minZoom = -std::numeric_limits<float>::infinity();
     float maxZoom = std::numeric_limits<float>::infinity();
     VisibilityType visibility = VisibilityType::Visible;
@@ -90,8 +99,16 @@ protected:
     // Stores what render passes this layer is currently enabled for. This depends on the
     // evaluated StyleProperties object and is updated accordingly.
     RenderPass passes = RenderPass::None;
+
+private:
+    // The zoom level the paint properties were last calculated for, if they were final.
+    optional<float> calculatedZoom;
 };
 
+// Copies of the style's layers as of a particular style change. Worker threads share them
+// without synchronization, so they must not be modified.
+using StyleLayerSnapshot = std::shared_ptr<const std::vector<std::unique_ptr<StyleLayer>>>;
+
 } // namespace mbgl
 
 #endif
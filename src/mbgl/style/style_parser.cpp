@@ -103,8 +103,13 @@ void parseTileJSONMember(const JSValue& value, std::array<double, 4>& target, co
 StyleParser::~StyleParser() = default;
 
 void StyleParser::parse(const std::string& json) {
+    // Parsing in place makes the strings in the document point into the buffer instead of
+    // allocating a copy of each of them.
+    std::vector<char> buffer(json.begin(), json.end());
+    buffer.push_back('\0');
+
     rapidjson::GenericDocument<rapidjson::UTF8<>, rapidjson::CrtAllocator> document;
-    document.Parse<0>(json.c_str());
+    document.ParseInsitu<0>(buffer.data());
 
     if (document.HasParseError()) {
         Log::Error(Event::ParseStyle, "Error parsing style JSON at %i: %s", document.GetErrorOffset(), rapidjson::GetParseError_En(document.GetParseError()));
@@ -448,7 +453,7 @@ void StyleParser::parseLayer(const std::string& id, const JSValue& value, std::u
         }
 
         if (value.HasMember("filter")) {
-            layer->filter = parseFilterExpression(value["filter"]);
+            layer->filter = CompiledFilter(parseFilterExpression(value["filter"]));
         }
 
         if (value.HasMember("minzoom")) {
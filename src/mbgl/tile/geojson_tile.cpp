@@ -14,12 +14,12 @@ FeatureType GeoJSONTileFeature::getType() const {
     return type;
 }
 
-optional<Value> GeoJSONTileFeature::getValue(const std::string& key) const {
+const Value* GeoJSONTileFeature::findValue(const std::string& key) const {
     auto it = tags.find(key);
     if (it != tags.end()) {
-        return optional<Value>(it->second);
+        return &it->second;
     }
-    return optional<Value>();
+    return nullptr;
 }
 
 GeometryCollection GeoJSONTileFeature::getGeometries() const {
@@ -19,11 +19,11 @@ namespace mbgl {
 
 class GeoJSONTileFeature : public GeometryTileFeature {
 public:
-    using Tags = std::unordered_map<std::string, std::string>;
+    using Tags = std::unordered_map<std::string, Value>;
 
     GeoJSONTileFeature(FeatureType, GeometryCollection&&, Tags&& = Tags{});
     FeatureType getType() const override;
-    optional<Value> getValue(const std::string&) const override;
+    const Value* findValue(const std::string&) const override;
     GeometryCollection getGeometries() const override;
 
 private:
@@ -5,11 +5,16 @@
 namespace mbgl {
 
 optional<Value> GeometryTileFeatureExtractor::getValue(const std::string& key) const {
+    const Value* value = findValue(key);
+    return value ? optional<Value>(*value) : optional<Value>();
+}
+
+const Value* GeometryTileFeatureExtractor::findValue(const std::string& key) const {
     if (key == "$type") {
-        return Value(uint64_t(feature.getType()));
+        return &type;
     }
 
-    return feature.getValue(key);
+    return feature.findValue(key);
 }
 
 template bool evaluate(const FilterExpression&, const GeometryTileFeatureExtractor&);
@@ -4,6 +4,7 @@
 #include <mapbox/variant.hpp>
 
 #include <mbgl/style/value.hpp>
+#include <mbgl/storage/resource.hpp>
 #include <mbgl/util/chrono.hpp>
 #include <mbgl/util/ptr.hpp>
 #include <mbgl/util/vec.hpp>
@@ -37,7 +38,16 @@ public:
 
     virtual ~GeometryTileFeature() = default;
     virtual FeatureType getType() const = 0;
-    virtual optional<Value> getValue(const std::string& key) const = 0;
+
+    // Returns the value of a property without copying it, or nullptr if the feature doesn't
+    // have the property. The value is owned by the tile and stays valid as long as the feature.
+    virtual const Value* findValue(const std::string& key) const = 0;
+
+    optional<Value> getValue(const std::string& key) const {
+        const Value* value = findValue(key);
+        return value ? optional<Value>(*value) : optional<Value>();
+    }
+
     virtual GeometryCollection getGeometries() const = 0;
     virtual uint32_t getExtent() const { return defaultExtent; }
 };
@@ -74,17 +84,23 @@ public:
      * To cease monitoring, release the returned Request.
      */
     virtual std::unique_ptr<AsyncRequest> monitorTile(const Callback&) = 0;
+
+    // Changes the priority of a request returned by monitorTile(). Monitors that don't load
+    // tiles from a FileSource ignore it.
+    virtual void setPriority(AsyncRequest&, Resource::Priority) {}
 };
 
 class GeometryTileFeatureExtractor {
 public:
     GeometryTileFeatureExtractor(const GeometryTileFeature& feature_)
-        : feature(feature_) {}
+        : feature(feature_), type(uint64_t(feature_.getType())) {}
 
     optional<Value> getValue(const std::string& key) const;
+    const Value* findValue(const std::string& key) const;
 
 private:
     const GeometryTileFeature& feature;
+    const Value type;
 };
 
 } // namespace mbgl
@@ -13,11 +13,12 @@ RasterTileData::RasterTileData(const TileID& id_,
                                const std::string& urlTemplate,
                                gl::TexturePool &texturePool_,
                                Worker& worker_,
-                               FileSource& fileSource,
+                               FileSource& fileSource_,
                                const std::function<void(std::exception_ptr)>& callback)
     : TileData(id_),
       texturePool(texturePool_),
-      worker(worker_) {
+      worker(worker_),
+      fileSource(fileSource_) {
     state = State::loading;
 
     const Resource resource = Resource::tile(urlTemplate, pixelRatio, id.x, id.y, id.sourceZ);
@@ -33,6 +34,7 @@ RasterTileData::RasterTileData(const TileID& id_,
             expires = res.expires;
             workRequest.reset();
             bucket.reset();
+            bucketsChanged();
             callback(nullptr);
         } else {
             modified = res.modified;
@@ -54,10 +56,12 @@ RasterTileData::RasterTileData(const TileID& id_,
                 if (result.is<std::unique_ptr<Bucket>>()) {
                     state = State::parsed;
                     bucket = std::move(result.get<std::unique_ptr<Bucket>>());
+                    bucketsChanged();
                 } else {
                     error = result.get<std::exception_ptr>();
                     state = State::obsolete;
                     bucket.reset();
+                    bucketsChanged();
                 }
 
                 callback(error);
@@ -74,6 +78,12 @@ Bucket* RasterTileData::getBucket(StyleLayer const&) {
     return bucket.get();
 }
 
+void RasterTileData::priorityChanged() {
+    if (req) {
+        fileSource.setPriority(*req, priority);
+    }
+}
+
 void RasterTileData::cancel() {
     if (state != State::obsolete) {
         state = State::obsolete;
@@ -26,8 +26,11 @@ public:
     Bucket* getBucket(StyleLayer const &layer_desc) override;
 
 private:
+    void priorityChanged() override;
+
     gl::TexturePool& texturePool;
     Worker& worker;
+    FileSource& fileSource;
     std::unique_ptr<AsyncRequest> req;
     std::unique_ptr<Bucket> bucket;
     std::unique_ptr<AsyncRequest> workRequest;
@@ -4,13 +4,27 @@
 
 namespace mbgl {
 
+static std::atomic<uint64_t> nextBucketsVersion { 0 };
+
 TileData::TileData(const TileID& id_)
     : id(id_),
-      state(State::initial) {
+      state(State::initial),
+      bucketsVersion(nextBucketsVersion++) {
+}
+
+void TileData::bucketsChanged() {
+    bucketsVersion = nextBucketsVersion++;
 }
 
 TileData::~TileData() = default;
 
+void TileData::setPriority(Resource::Priority priority_) {
+    if (priority != priority_) {
+        priority = priority_;
+        priorityChanged();
+    }
+}
+
 const char* TileData::StateToString(const State state) {
     switch (state) {
         case TileData::State::initial: return "initial";
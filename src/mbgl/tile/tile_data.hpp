@@ -7,6 +7,7 @@
 #include <mbgl/map/tile_id.hpp>
 #include <mbgl/renderer/bucket.hpp>
 #include <mbgl/text/placement_config.hpp>
+#include <mbgl/storage/resource.hpp>
 
 #include <atomic>
 #include <string>
@@ -82,6 +83,10 @@ public:
     virtual void redoPlacement(PlacementConfig, const std::function<void()>&) {}
     virtual void redoPlacement(const std::function<void()>&) {}
 
+    // Changes the priority of the request for this tile's data. Source demotes tiles that
+    // only stand in for the ideal tiles while those are loading.
+    void setPriority(Resource::Priority);
+
     bool isReady() const {
         return isReadyState(state);
     }
@@ -90,6 +95,13 @@ public:
         return state;
     }
 
+    // Changes whenever buckets are added, removed or replaced. Versions are unique across
+    // all tiles, so that a tile allocated at the address of a destroyed one doesn't have
+    // the same version.
+    uint64_t getBucketsVersion() const {
+        return bucketsVersion;
+    }
+
     void dumpDebugLogs() const;
 
     const TileID id;
@@ -99,8 +111,22 @@ public:
     // Contains the tile ID string for painting debug information.
     std::unique_ptr<DebugBucket> debugBucket;
 
+    // Set by the painter once the buckets it renders for this tile were uploaded for the first
+    // time. Until then, the tile isn't drawn and Source covers it with parent or child tiles.
+    bool uploaded = false;
+
 protected:
+    void bucketsChanged();
+
+    // Called when the priority changed; subclasses forward it to their pending request.
+    virtual void priorityChanged() {}
+
+    Resource::Priority priority = Resource::Priority::Regular;
+
     std::atomic<State> state;
+
+private:
+    uint64_t bucketsVersion;
 };
 
 } // namespace mbgl
@@ -36,7 +36,7 @@ TileWorker::~TileWorker() {
     glyphAtlas.removeGlyphs(reinterpret_cast<uintptr_t>(this));
 }
 
-TileParseResult TileWorker::parseAllLayers(std::vector<std::unique_ptr<StyleLayer>> layers_,
+TileParseResult TileWorker::parseAllLayers(StyleLayerSnapshot layers_,
                                            std::unique_ptr<const GeometryTile> geometryTile,
                                            PlacementConfig config) {
     // We're doing a fresh parse of the tile, because the underlying data has changed.
@@ -51,7 +51,7 @@ TileParseResult TileWorker::parseAllLayers(std::vector<std::unique_ptr<StyleLaye
     // referenced from more than one layer
     std::set<std::string> parsed;
 
-    for (auto i = layers.rbegin(); i != layers.rend(); i++) {
+    for (auto i = layers->rbegin(); i != layers->rend(); i++) {
         const StyleLayer* layer = i->get();
         if (parsed.find(layer->bucketName()) == parsed.end()) {
             parsed.emplace(layer->bucketName());
@@ -112,9 +112,14 @@ void TileWorker::redoPlacement(
     const std::unordered_map<std::string, std::unique_ptr<Bucket>>* buckets,
     PlacementConfig config) {
 
+    if (!layers) {
+        // Nothing was parsed yet.
+        return;
+    }
+
     CollisionTile collisionTile(config);
 
-    for (auto i = layers.rbegin(); i != layers.rend(); i++) {
+    for (auto i = layers->rbegin(); i != layers->rend(); i++) {
         const auto it = buckets->find((*i)->id);
         if (it != buckets->end()) {
             it->second->placeFeatures(collisionTile);
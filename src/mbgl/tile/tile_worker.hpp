@@ -5,6 +5,7 @@
 
 #include <mbgl/map/mode.hpp>
 #include <mbgl/tile/tile_data.hpp>
+#include <mbgl/style/style_layer.hpp>
 #include <mbgl/util/noncopyable.hpp>
 #include <mbgl/util/ptr.hpp>
 #include <mbgl/text/placement_config.hpp>
@@ -23,7 +24,6 @@ class SpriteStore;
 class GlyphAtlas;
 class GlyphStore;
 class Bucket;
-class StyleLayer;
 class SymbolLayer;
 
 // We're using this class to shuttle the resulting buckets from the worker thread to the MapContext
@@ -49,7 +49,7 @@ public:
                const MapMode);
     ~TileWorker();
 
-    TileParseResult parseAllLayers(std::vector<std::unique_ptr<StyleLayer>>,
+    TileParseResult parseAllLayers(StyleLayerSnapshot,
                                    std::unique_ptr<const GeometryTile> geometryTile,
                                    PlacementConfig);
 
@@ -74,7 +74,8 @@ private:
 
     bool partialParse = false;
 
-    std::vector<std::unique_ptr<StyleLayer>> layers;
+    // Keeps the layers alive that pending buckets refer to.
+    StyleLayerSnapshot layers;
 
     // Contains buckets that we couldn't parse so far due to missing resources.
     // They will be attempted on subsequent parses.
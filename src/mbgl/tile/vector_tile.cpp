@@ -53,10 +53,10 @@ VectorTileFeature::VectorTileFeature(pbf feature_pbf, const VectorTileLayer& lay
     }
 }
 
-optional<Value> VectorTileFeature::getValue(const std::string& key) const {
+const Value* VectorTileFeature::findValue(const std::string& key) const {
     auto keyIter = layer.keys.find(key);
     if (keyIter == layer.keys.end()) {
-        return optional<Value>();
+        return nullptr;
     }
 
     pbf tags = tags_pbf;
@@ -77,11 +77,11 @@ optional<Value> VectorTileFeature::getValue(const std::string& key) const {
         }
 
         if (tag_key == keyIter->second) {
-            return layer.values[tag_val];
+            return &layer.values[tag_val];
         }
     }
 
-    return optional<Value>();
+    return nullptr;
 }
 
 GeometryCollection VectorTileFeature::getGeometries() const {
@@ -203,4 +203,8 @@ std::unique_ptr<AsyncRequest> VectorTileMonitor::monitorTile(const GeometryTileM
     });
 }
 
+void VectorTileMonitor::setPriority(AsyncRequest& request, Resource::Priority priority) {
+    fileSource.setPriority(request, priority);
+}
+
 } // namespace mbgl
@@ -6,6 +6,7 @@
 #include <mbgl/util/pbf.hpp>
 
 #include <map>
+#include <unordered_map>
 
 namespace mbgl {
 
@@ -16,7 +17,7 @@ public:
     VectorTileFeature(pbf, const VectorTileLayer&);
 
     FeatureType getType() const override { return type; }
-    optional<Value> getValue(const std::string&) const override;
+    const Value* findValue(const std::string&) const override;
     GeometryCollection getGeometries() const override;
     uint32_t getExtent() const override;
 
@@ -41,7 +42,7 @@ private:
 
     std::string name;
     uint32_t extent = 4096;
-    std::map<std::string, uint32_t> keys;
+    std::unordered_map<std::string, uint32_t> keys;
     std::vector<Value> values;
     std::vector<pbf> features;
 };
@@ -66,6 +67,7 @@ public:
     VectorTileMonitor(const TileID&, float pixelRatio, const std::string& urlTemplate, FileSource&);
 
     std::unique_ptr<AsyncRequest> monitorTile(const GeometryTileMonitor::Callback&) override;
+    void setPriority(AsyncRequest&, Resource::Priority) override;
 
 private:
     TileID tileID;
@@ -44,6 +44,7 @@ VectorTileData::VectorTileData(const TileID& id_,
             workRequest.reset();
             state = State::parsed;
             buckets.clear();
+            bucketsChanged();
             callback(err);
             return;
         }
@@ -58,7 +59,7 @@ VectorTileData::VectorTileData(const TileID& id_,
         // when tile data changed. Replacing the workdRequest will cancel a pending work
         // request in case there is one.
         workRequest.reset();
-        workRequest = worker.parseGeometryTile(tileWorker, style.getLayers(), std::move(tile), targetConfig, [callback, this, config = targetConfig] (TileParseResult result) {
+        workRequest = worker.parseGeometryTile(tileWorker, style.getLayerSnapshot(), std::move(tile), targetConfig, [callback, this, config = targetConfig] (TileParseResult result) {
             workRequest.reset();
             if (state == State::obsolete) {
                 return;
@@ -76,6 +77,7 @@ VectorTileData::VectorTileData(const TileID& id_,
                 // Move over all buckets we received in this parse request, potentially overwriting
                 // existing buckets in case we got a refresh parse.
                 buckets = std::move(resultBuckets.buckets);
+                bucketsChanged();
 
             } else {
                 error = result.get<std::exception_ptr>();
@@ -114,6 +116,7 @@ bool VectorTileData::parsePending(std::function<void(std::exception_ptr)> callba
             for (auto& bucket : resultBuckets.buckets) {
                 buckets[bucket.first] = std::move(bucket.second);
             }
+            bucketsChanged();
 
             // Persist the configuration we just placed so that we can later check whether we need to
             // place again in case the configuration has changed.
@@ -174,6 +177,12 @@ void VectorTileData::redoPlacement(const std::function<void()>& callback) {
     });
 }
 
+void VectorTileData::priorityChanged() {
+    if (tileRequest) {
+        monitor->setPriority(*tileRequest, priority);
+    }
+}
+
 void VectorTileData::cancel() {
     state = State::obsolete;
     tileRequest.reset();
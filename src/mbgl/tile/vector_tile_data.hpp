@@ -36,6 +36,8 @@ public:
     void cancel() override;
 
 private:
+    void priorityChanged() override;
+
     Style& style;
     Worker& worker;
     TileWorker tileWorker;
@@ -111,6 +111,47 @@ bool coveredByChildren(const TileID& id, const Container& container) {
     return true;
 }
 
+bool ClipIDCache::update(const std::vector<std::forward_list<Tile *>>& sources) {
+    // The generated IDs only depend on the tile IDs of each source, in order.
+    bool unchanged = true;
+    auto entry = entries.begin();
+    for (std::size_t source = 0; source < sources.size() && unchanged; source++) {
+        for (const Tile* tile : sources[source]) {
+            if (entry == entries.end() || entry->source != source || entry->id != tile->id) {
+                unchanged = false;
+                break;
+            }
+            ++entry;
+        }
+    }
+    unchanged = unchanged && entry == entries.end();
+
+    if (unchanged) {
+        // Assign the IDs again, since a tile may have been replaced by one with the same ID.
+        entry = entries.begin();
+        for (const auto& tiles : sources) {
+            for (Tile* tile : tiles) {
+                tile->clip = (entry++)->clip;
+            }
+        }
+        return false;
+    }
+
+    ClipIDGenerator generator;
+    for (const auto& tiles : sources) {
+        generator.update(tiles);
+    }
+    stencils = generator.getStencils();
+
+    entries.clear();
+    for (std::size_t source = 0; source < sources.size(); source++) {
+        for (const Tile* tile : sources[source]) {
+            entries.push_back({ source, tile->id, tile->clip });
+        }
+    }
+    return true;
+}
+
 std::map<TileID, ClipID> ClipIDGenerator::getStencils() const {
     std::map<TileID, ClipID> stencils;
 
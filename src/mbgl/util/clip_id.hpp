@@ -54,6 +54,27 @@ public:
     std::map<TileID, ClipID> getStencils() const;
 };
 
+// Assigns clip IDs to the loaded tiles of a set of sources. Clip IDs only depend on which tiles
+// are loaded, so the IDs of the previous update are assigned again as long as that doesn't change,
+// e.g. while panning within the same tiles.
+class ClipIDCache {
+public:
+    // Takes the loaded tiles of each source. Returns whether the clip IDs changed.
+    bool update(const std::vector<std::forward_list<Tile *>>& sources);
+
+    const std::map<TileID, ClipID>& getStencils() const { return stencils; }
+
+private:
+    struct Entry {
+        std::size_t source;
+        TileID id;
+        ClipID clip;
+    };
+
+    std::vector<Entry> entries;
+    std::map<TileID, ClipID> stencils;
+};
+
 
 } // namespace mbgl
 
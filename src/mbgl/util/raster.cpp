@@ -47,6 +47,7 @@ void Raster::bind(bool linear, gl::GLObjectStore& glObjectStore) {
         upload(glObjectStore);
     } else if (textured) {
         MBGL_CHECK_ERROR(glBindTexture(GL_TEXTURE_2D, textureID));
+        glObjectStore.counters.textureBinds++;
     }
 
     GLint new_filter = linear ? GL_LINEAR : GL_NEAREST;
@@ -61,12 +62,14 @@ void Raster::upload(gl::GLObjectStore& glObjectStore) {
     if (img.data && !textured) {
         textureID = texturePool.getTextureID(glObjectStore);
         MBGL_CHECK_ERROR(glBindTexture(GL_TEXTURE_2D, textureID));
+        glObjectStore.counters.textureBinds++;
 #ifndef GL_ES_VERSION_2_0
         MBGL_CHECK_ERROR(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0));
 #endif
         MBGL_CHECK_ERROR(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE));
         MBGL_CHECK_ERROR(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE));
         MBGL_CHECK_ERROR(glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, img.data.get()));
+        glObjectStore.counters.bytesUploaded += width * height * 4;
         img.data.reset();
         textured = true;
     }
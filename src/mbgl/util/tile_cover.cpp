@@ -2,6 +2,7 @@
 #include <mbgl/util/vec.hpp>
 #include <mbgl/util/constants.hpp>
 #include <mbgl/util/interpolate.hpp>
+#include <mbgl/util/optional.hpp>
 #include <mbgl/map/transform_state.hpp>
 
 namespace mbgl {
@@ -136,17 +137,26 @@ std::vector<TileID> tileCover(const TileCoordinate& tl,
     return std::vector<TileID>(t.begin(), t.end());
 }
 
-std::vector<TileID> tileCover(const LatLngBounds& bounds_, int32_t z, int32_t actualZ) {
-    if (bounds_.isEmpty() ||
-        bounds_.south() >  util::LATITUDE_MAX ||
-        bounds_.north() < -util::LATITUDE_MAX) {
+// Clamps the bounds to the latitudes that Web Mercator can represent.
+static optional<LatLngBounds> mercatorBounds(const LatLngBounds& bounds) {
+    if (bounds.isEmpty() ||
+        bounds.south() >  util::LATITUDE_MAX ||
+        bounds.north() < -util::LATITUDE_MAX) {
         return {};
     }
 
-    LatLngBounds bounds = LatLngBounds::hull(
-        { std::max(bounds_.south(), -util::LATITUDE_MAX), bounds_.west() },
-        { std::min(bounds_.north(),  util::LATITUDE_MAX), bounds_.east() });
+    return LatLngBounds::hull(
+        { std::max(bounds.south(), -util::LATITUDE_MAX), bounds.west() },
+        { std::min(bounds.north(),  util::LATITUDE_MAX), bounds.east() });
+}
 
+std::vector<TileID> tileCover(const LatLngBounds& bounds_, int32_t z, int32_t actualZ) {
+    const optional<LatLngBounds> clamped = mercatorBounds(bounds_);
+    if (!clamped) {
+        return {};
+    }
+
+    const LatLngBounds& bounds = *clamped;
     const TransformState state;
     return tileCover(
         TileCoordinate::fromLatLng(state, z, bounds.northwest()),
@@ -157,6 +167,27 @@ std::vector<TileID> tileCover(const LatLngBounds& bounds_, int32_t z, int32_t ac
         z, actualZ);
 }
 
+uint64_t tileCount(const LatLngBounds& bounds_, int32_t z) {
+    const optional<LatLngBounds> bounds = mercatorBounds(bounds_);
+    if (!bounds) {
+        return 0;
+    }
+
+    // The bounds are a rectangle in tile coordinates, so their cover is the range of tiles
+    // that the rectangle touches. Like the scan lines, a rectangle without height covers nothing.
+    const TransformState state;
+    const TileCoordinate nw = TileCoordinate::fromLatLng(state, z, bounds->northwest());
+    const TileCoordinate se = TileCoordinate::fromLatLng(state, z, bounds->southeast());
+    if (nw.y == se.y) {
+        return 0;
+    }
+
+    const double tiles = 1 << z;
+    const double columns = std::ceil(se.x) - std::floor(nw.x);
+    const double rows = std::min(tiles, std::ceil(se.y)) - std::max(0.0, std::floor(nw.y));
+    return rows > 0 ? static_cast<uint64_t>(columns) * static_cast<uint64_t>(rows) : 0;
+}
+
 std::vector<TileID> tileCover(const TransformState& state, int32_t z, int32_t actualZ) {
     const double w = state.getWidth();
     const double h = state.getHeight();
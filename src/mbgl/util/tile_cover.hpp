@@ -16,6 +16,9 @@ int32_t coveringZoomLevel(double z, SourceType type, uint16_t tileSize);
 std::vector<TileID> tileCover(const TransformState&, int32_t z, int32_t actualZ);
 std::vector<TileID> tileCover(const LatLngBounds&,   int32_t z, int32_t actualZ);
 
+// The number of tiles in tileCover() of the bounds, computed without enumerating them.
+uint64_t tileCount(const LatLngBounds&, int32_t z);
+
 } // namespace mbgl
 
 #endif
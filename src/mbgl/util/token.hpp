@@ -4,6 +4,7 @@
 #include <map>
 #include <string>
 #include <algorithm>
+#include <vector>
 
 namespace mbgl {
 namespace util {
@@ -38,6 +39,67 @@ std::string replaceTokens(const std::string &source, const Lookup &lookup) {
     return result;
 }
 
+// A string with {tokens} that is split into literal text and token names once, so that the
+// tokens can be replaced for many features without scanning the string again. Tokens are
+// recognized the same way as by replaceTokens().
+class TokenString {
+public:
+    TokenString() = default;
+
+    explicit TokenString(const std::string &source) {
+        auto pos = source.begin();
+        const auto end = source.end();
+
+        while (pos != end) {
+            auto brace = std::find(pos, end, '{');
+            appendText(pos, brace);
+            pos = brace;
+            if (pos != end) {
+                for (brace++; brace != end && tokenReservedChars.find(*brace) == std::string::npos; brace++);
+                if (brace != end && *brace == '}') {
+                    segments.push_back({ { pos + 1, brace }, true });
+                    pos = brace + 1;
+                } else {
+                    appendText(pos, brace);
+                    pos = brace;
+                }
+            }
+        }
+    }
+
+    // Appends the string to result. Calls lookup(token, result) to append the value of each
+    // token, which avoids creating a temporary string for every value.
+    template <typename Lookup>
+    void appendTo(std::string &result, const Lookup &lookup) const {
+        for (const auto& segment : segments) {
+            if (segment.token) {
+                lookup(segment.text, result);
+            } else {
+                result.append(segment.text);
+            }
+        }
+    }
+
+private:
+    void appendText(std::string::const_iterator begin, std::string::const_iterator end) {
+        if (begin == end) {
+            return;
+        }
+        if (!segments.empty() && !segments.back().token) {
+            segments.back().text.append(begin, end);
+        } else {
+            segments.push_back({ { begin, end }, false });
+        }
+    }
+
+    struct Segment {
+        std::string text;
+        bool token;
+    };
+
+    std::vector<Segment> segments;
+};
+
 } // end namespace util
 } // end namespace mbgl
 
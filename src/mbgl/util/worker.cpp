@@ -11,11 +11,34 @@
 
 namespace mbgl {
 
+// Bound to every task we submit. It's destroyed when the task finished running, or when a
+// cancelled task is dropped from the queue, and takes the task off the queue depth then.
+class Worker::QueueToken {
+public:
+    explicit QueueToken(std::atomic<std::size_t>& depth_) : depth(&depth_) {
+        ++*depth;
+    }
+
+    QueueToken(QueueToken&& o) noexcept : depth(o.depth) { o.depth = nullptr; }
+    QueueToken(const QueueToken&) = delete;
+    QueueToken& operator=(const QueueToken&) = delete;
+
+    ~QueueToken() {
+        if (depth) {
+            --*depth;
+        }
+    }
+
+private:
+    std::atomic<std::size_t>* depth;
+};
+
 class Worker::Impl {
 public:
     Impl() = default;
 
-    void parseRasterTile(std::unique_ptr<RasterBucket> bucket,
+    void parseRasterTile(QueueToken,
+                         std::unique_ptr<RasterBucket> bucket,
                          std::shared_ptr<const std::string> data,
                          std::function<void(RasterTileParseResult)> callback) {
         try {
@@ -28,8 +51,9 @@ public:
         }
     }
 
-    void parseGeometryTile(TileWorker* worker,
-                           std::vector<std::unique_ptr<StyleLayer>> layers,
+    void parseGeometryTile(QueueToken,
+                           TileWorker* worker,
+                           StyleLayerSnapshot layers,
                            std::unique_ptr<GeometryTile> tile,
                            PlacementConfig config,
                            std::function<void(TileParseResult)> callback) {
@@ -40,7 +64,8 @@ public:
         }
     }
 
-    void parsePendingGeometryTileLayers(TileWorker* worker,
+    void parsePendingGeometryTileLayers(QueueToken,
+                                        TileWorker* worker,
                                         PlacementConfig config,
                                         std::function<void(TileParseResult)> callback) {
         try {
@@ -50,7 +75,8 @@ public:
         }
     }
 
-    void redoPlacement(TileWorker* worker,
+    void redoPlacement(QueueToken,
+                       TileWorker* worker,
                        const std::unordered_map<std::string, std::unique_ptr<Bucket>>* buckets,
                        PlacementConfig config,
                        std::function<void()> callback) {
@@ -59,42 +85,58 @@ public:
     }
 };
 
-Worker::Worker(std::size_t count) {
+Worker::Worker(std::size_t count)
+    : depths(std::make_unique<std::atomic<std::size_t>[]>(count)) {
     util::ThreadContext context = { "Worker", util::ThreadType::Worker, util::ThreadPriority::Low };
     for (std::size_t i = 0; i < count; i++) {
+        depths[i] = 0;
         threads.emplace_back(std::make_unique<util::Thread<Impl>>(context));
     }
 }
 
 Worker::~Worker() = default;
 
+Worker::QueueToken Worker::enqueue() {
+    current = (current + 1) % threads.size();
+    return QueueToken(depths[current]);
+}
+
+std::vector<std::size_t> Worker::queueDepths() const {
+    std::vector<std::size_t> result;
+    for (std::size_t i = 0; i < threads.size(); i++) {
+        result.push_back(depths[i]);
+    }
+    return result;
+}
+
 std::unique_ptr<AsyncRequest>
 Worker::parseRasterTile(std::unique_ptr<RasterBucket> bucket,
                         const std::shared_ptr<const std::string> data,
                         std::function<void(RasterTileParseResult)> callback) {
-    current = (current + 1) % threads.size();
-    return threads[current]->invokeWithCallback(&Worker::Impl::parseRasterTile, callback, bucket,
-                                                data);
+    QueueToken token = enqueue();
+    return threads[current]->invokeWithCallback(&Worker::Impl::parseRasterTile, callback,
+                                                std::move(token), bucket, data);
 }
 
 std::unique_ptr<AsyncRequest>
 Worker::parseGeometryTile(TileWorker& worker,
-                          std::vector<std::unique_ptr<StyleLayer>> layers,
+                          StyleLayerSnapshot layers,
                           std::unique_ptr<GeometryTile> tile,
                           PlacementConfig config,
                           std::function<void(TileParseResult)> callback) {
-    current = (current + 1) % threads.size();
-    return threads[current]->invokeWithCallback(&Worker::Impl::parseGeometryTile, callback, &worker,
-                                                std::move(layers), std::move(tile), config);
+    QueueToken token = enqueue();
+    return threads[current]->invokeWithCallback(&Worker::Impl::parseGeometryTile, callback,
+                                                std::move(token), &worker, std::move(layers),
+                                                std::move(tile), config);
 }
 
 std::unique_ptr<AsyncRequest>
 Worker::parsePendingGeometryTileLayers(TileWorker& worker,
                                        PlacementConfig config,
                                        std::function<void(TileParseResult)> callback) {
-    current = (current + 1) % threads.size();
+    QueueToken token = enqueue();
     return threads[current]->invokeWithCallback(&Worker::Impl::parsePendingGeometryTileLayers,
-                                                callback, &worker, config);
+                                                callback, std::move(token), &worker, config);
 }
 
 std::unique_ptr<AsyncRequest>
@@ -102,9 +144,9 @@ Worker::redoPlacement(TileWorker& worker,
                       const std::unordered_map<std::string, std::unique_ptr<Bucket>>& buckets,
                       PlacementConfig config,
                       std::function<void()> callback) {
-    current = (current + 1) % threads.size();
-    return threads[current]->invokeWithCallback(&Worker::Impl::redoPlacement, callback, &worker,
-                                                &buckets, config);
+    QueueToken token = enqueue();
+    return threads[current]->invokeWithCallback(&Worker::Impl::redoPlacement, callback,
+                                                std::move(token), &worker, &buckets, config);
 }
 
 } // end namespace mbgl
@@ -5,8 +5,10 @@
 #include <mbgl/util/thread.hpp>
 #include <mbgl/tile/tile_worker.hpp>
 
+#include <atomic>
 #include <functional>
 #include <memory>
+#include <vector>
 
 namespace mbgl {
 
@@ -40,7 +42,7 @@ public:
                             std::function<void(RasterTileParseResult)> callback);
 
     Request parseGeometryTile(TileWorker&,
-                              std::vector<std::unique_ptr<StyleLayer>>,
+                              StyleLayerSnapshot,
                               std::unique_ptr<GeometryTile>,
                               PlacementConfig,
                               std::function<void(TileParseResult)> callback);
@@ -54,8 +56,17 @@ public:
                           PlacementConfig config,
                           std::function<void()> callback);
 
+    // Number of tasks that are queued or running on each thread.
+    std::vector<std::size_t> queueDepths() const;
+
 private:
     class Impl;
+    class QueueToken;
+
+    QueueToken enqueue();
+
+    // Indexed like threads; declared first so that it outlives the tasks they destroy.
+    std::unique_ptr<std::atomic<std::size_t>[]> depths;
     std::vector<std::unique_ptr<util::Thread<Impl>>> threads;
     std::size_t current = 0;
 };
@@ -0,0 +1,43 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/map/map.hpp>
+#include <mbgl/platform/default/headless_display.hpp>
+#include <mbgl/platform/default/headless_view.hpp>
+#include <mbgl/storage/online_file_source.hpp>
+
+using namespace mbgl;
+
+TEST(API, FrameProfile) {
+    auto display = std::make_shared<mbgl::HeadlessDisplay>();
+    HeadlessView view(display, 1);
+    OnlineFileSource fileSource;
+
+    Map map(view, fileSource, MapMode::Still);
+
+    std::vector<FrameProfile> profiles;
+    map.setFrameProfileCallback([&](const FrameProfile& profile) {
+        profiles.push_back(profile);
+    });
+
+    map.setStyleJSON(R"STYLE({
+      "version": 8,
+      "sources": {},
+      "layers": [{
+        "id": "background",
+        "type": "background",
+        "paint": { "background-color": "red" }
+      }]
+    })STYLE", "");
+
+    test::render(map);
+
+    // Runs on the map thread, so the frame has been fully delivered once it returns.
+    map.getRenderStatistics();
+
+    ASSERT_EQ(1u, profiles.size());
+    const FrameProfile& profile = profiles.front();
+    EXPECT_TRUE(profile.sources.empty());
+    EXPECT_FALSE(profile.workerQueueDepths.empty());
+    EXPECT_GT(profile.total, Duration::zero());
+    EXPECT_GE(profile.total, profile.upload + profile.clip + profile.opaquePass + profile.translucentPass);
+}
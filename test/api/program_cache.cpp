@@ -0,0 +1,96 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/map/map.hpp>
+#include <mbgl/platform/default/headless_display.hpp>
+#include <mbgl/platform/default/headless_view.hpp>
+#include <mbgl/storage/online_file_source.hpp>
+
+#include <cstdlib>
+#include <map>
+#include <string>
+
+#include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utime.h>
+
+using namespace mbgl;
+
+namespace {
+
+const char* style = R"STYLE({
+  "version": 8,
+  "sources": {},
+  "layers": [{
+    "id": "background",
+    "type": "background",
+    "paint": { "background-color": "red" }
+  }]
+})STYLE";
+
+void renderWithCache(const std::string& path) {
+    auto display = std::make_shared<mbgl::HeadlessDisplay>();
+    HeadlessView view(display, 1);
+    OnlineFileSource fileSource;
+
+    Map map(view, fileSource, MapMode::Still);
+    map.setShaderCachePath(path);
+    map.setStyleJSON(style, "");
+
+    test::render(map);
+}
+
+// Modification times of the files in a directory, by name.
+std::map<std::string, time_t> listFiles(const std::string& path) {
+    std::map<std::string, time_t> files;
+    DIR* dir = opendir(path.c_str());
+    if (!dir) {
+        return files;
+    }
+    while (dirent* entry = readdir(dir)) {
+        const std::string name = entry->d_name;
+        struct stat info;
+        if (stat((path + "/" + name).c_str(), &info) == 0 && S_ISREG(info.st_mode)) {
+            files.emplace(name, info.st_mtime);
+        }
+    }
+    closedir(dir);
+    return files;
+}
+
+} // namespace
+
+TEST(API, ProgramCache) {
+    char pathTemplate[] = "/tmp/mbgl-program-cache-XXXXXX";
+    ASSERT_NE(nullptr, mkdtemp(pathTemplate));
+    const std::string path = pathTemplate;
+
+    renderWithCache(path);
+
+    auto files = listFiles(path);
+    if (files.empty()) {
+        // The driver doesn't support retrieving program binaries.
+        rmdir(path.c_str());
+        return;
+    }
+
+    for (const auto& file : files) {
+        // No temporary files are left behind.
+        EXPECT_EQ(".bin", file.first.substr(file.first.size() - 4));
+
+        // Backdate the files, so that rewriting them would show.
+        const std::string filename = path + "/" + file.first;
+        struct utimbuf times = { 1000, 1000 };
+        ASSERT_EQ(0, utime(filename.c_str(), &times));
+    }
+
+    // A second map loads the programs from the cache instead of compiling and storing them.
+    renderWithCache(path);
+
+    files = listFiles(path);
+    for (const auto& file : files) {
+        EXPECT_EQ(1000, file.second) << file.first;
+        unlink((path + "/" + file.first).c_str());
+    }
+    rmdir(path.c_str());
+}
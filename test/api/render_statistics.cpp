@@ -0,0 +1,83 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/map/map.hpp>
+#include <mbgl/platform/default/headless_display.hpp>
+#include <mbgl/platform/default/headless_view.hpp>
+#include <mbgl/storage/online_file_source.hpp>
+
+using namespace mbgl;
+
+TEST(API, RenderStatistics) {
+    auto display = std::make_shared<mbgl::HeadlessDisplay>();
+    HeadlessView view(display, 1);
+    OnlineFileSource fileSource;
+
+    Map map(view, fileSource, MapMode::Still);
+
+    EXPECT_EQ(0u, map.getRenderStatistics().total.drawCalls);
+
+    map.setStyleJSON(R"STYLE({
+      "version": 8,
+      "sources": {},
+      "layers": [{
+        "id": "background",
+        "type": "background",
+        "paint": { "background-color": "red" }
+      }]
+    })STYLE", "");
+
+    test::render(map);
+
+    const RenderStatistics statistics = map.getRenderStatistics();
+    EXPECT_GT(statistics.total.drawCalls, 0u);
+    EXPECT_GT(statistics.total.programSwitches, 0u);
+    EXPECT_GT(statistics.total.uniformUploads, 0u);
+
+    ASSERT_EQ(1u, statistics.layers.size());
+    const RenderCounters& background = statistics.layers.at("background");
+    EXPECT_GT(background.drawCalls, 0u);
+    EXPECT_LE(background.drawCalls, statistics.total.drawCalls);
+}
+
+TEST(API, RenderStatisticsStateChanges) {
+    auto display = std::make_shared<mbgl::HeadlessDisplay>();
+    HeadlessView view(display, 1);
+    OnlineFileSource fileSource;
+
+    Map map(view, fileSource, MapMode::Still);
+
+    map.setStyleJSON(R"STYLE({
+      "version": 8,
+      "sources": {},
+      "layers": [{
+        "id": "a",
+        "type": "background",
+        "paint": { "background-color": "red", "background-opacity": 0.5 }
+      }, {
+        "id": "b",
+        "type": "background",
+        "paint": { "background-color": "green", "background-opacity": 0.5 }
+      }, {
+        "id": "c",
+        "type": "background",
+        "paint": { "background-color": "blue", "background-opacity": 0.5 }
+      }, {
+        "id": "d",
+        "type": "background",
+        "paint": { "background-color": "white", "background-opacity": 0.5 }
+      }]
+    })STYLE", "");
+
+    test::render(map);
+
+    const RenderStatistics statistics = map.getRenderStatistics();
+    EXPECT_GT(statistics.total.stateChanges, 0u);
+
+    // The bottom layer is drawn with glClear(). Once "b" has set up blending and depth
+    // testing, the following layers with the same requirements only move to their own
+    // depth range.
+    ASSERT_EQ(1u, statistics.layers.count("c"));
+    ASSERT_EQ(1u, statistics.layers.count("d"));
+    EXPECT_EQ(1u, statistics.layers.at("c").stateChanges);
+    EXPECT_EQ(1u, statistics.layers.at("d").stateChanges);
+}
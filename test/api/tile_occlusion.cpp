@@ -0,0 +1,82 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/map/map.hpp>
+#include <mbgl/platform/default/headless_display.hpp>
+#include <mbgl/platform/default/headless_view.hpp>
+#include <mbgl/storage/online_file_source.hpp>
+
+using namespace mbgl;
+
+TEST(API, TileOcclusion) {
+    auto display = std::make_shared<mbgl::HeadlessDisplay>();
+    HeadlessView view(display, 1);
+    OnlineFileSource fileSource;
+
+    Map map(view, fileSource, MapMode::Still);
+
+    // "cover" is an opaque fill that covers the entire tile of the "world" source. The
+    // "below" layer of the same source is hidden underneath it, while "other" is drawn from
+    // the tile of another source.
+    map.setStyleJSON(R"STYLE({
+      "version": 8,
+      "sources": {
+        "world": {
+          "type": "geojson",
+          "data": {
+            "type": "Feature",
+            "properties": {},
+            "geometry": {
+              "type": "Polygon",
+              "coordinates": [[[-180, -89], [180, -89], [180, 89], [-180, 89], [-180, -89]]]
+            }
+          }
+        },
+        "small": {
+          "type": "geojson",
+          "data": {
+            "type": "Feature",
+            "properties": {},
+            "geometry": {
+              "type": "Polygon",
+              "coordinates": [[[-10, -10], [10, -10], [10, 10], [-10, 10], [-10, -10]]]
+            }
+          }
+        }
+      },
+      "layers": [{
+        "id": "background",
+        "type": "background",
+        "paint": { "background-color": "white" }
+      }, {
+        "id": "other",
+        "type": "fill",
+        "source": "small",
+        "paint": { "fill-color": "green" }
+      }, {
+        "id": "below",
+        "type": "fill",
+        "source": "world",
+        "paint": { "fill-color": "red" }
+      }, {
+        "id": "cover",
+        "type": "fill",
+        "source": "world",
+        "paint": { "fill-color": "blue" }
+      }, {
+        "id": "above",
+        "type": "fill",
+        "source": "world",
+        "paint": { "fill-color": "black", "fill-opacity": 0.5 }
+      }]
+    })STYLE", "");
+
+    test::render(map);
+
+    const RenderStatistics statistics = map.getRenderStatistics();
+
+    // Layers that weren't rendered in either pass have no statistics.
+    EXPECT_EQ(0u, statistics.layers.count("below"));
+    EXPECT_EQ(1u, statistics.layers.count("other"));
+    EXPECT_EQ(1u, statistics.layers.count("cover"));
+    EXPECT_EQ(1u, statistics.layers.count("above"));
+}
@@ -0,0 +1,69 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/geometry/elements_buffer.hpp>
+
+using namespace mbgl;
+
+namespace {
+
+// Gives access to the indices that were added.
+template <template <typename> class Elements, typename T>
+class Inspectable : public Elements<T> {
+public:
+    const T* get(GLsizei i) {
+        return static_cast<const T*>(this->getElement(i));
+    }
+};
+
+} // namespace
+
+TEST(ElementsBuffer, Convert) {
+    Inspectable<TriangleElements, uint16_t> triangles;
+    triangles.add(0, 1, 2);
+    triangles.add(65533, 65534, 65535);
+
+    Inspectable<TriangleElements, uint32_t> triangles32;
+    triangles32.add(triangles);
+    triangles32.add(65535, 65536, 65537);
+    ASSERT_EQ(3, triangles32.index());
+
+    // The 16 bit indices keep their values, up to the highest one they can address.
+    const uint32_t expectedTriangles[3][3] = {
+        { 0, 1, 2 }, { 65533, 65534, 65535 }, { 65535, 65536, 65537 }
+    };
+    for (GLsizei i = 0; i < 3; i++) {
+        EXPECT_EQ(expectedTriangles[i][0], triangles32.get(i)[0]);
+        EXPECT_EQ(expectedTriangles[i][1], triangles32.get(i)[1]);
+        EXPECT_EQ(expectedTriangles[i][2], triangles32.get(i)[2]);
+    }
+
+    Inspectable<LineElements, uint16_t> lines;
+    lines.add(0, 1);
+    lines.add(65534, 65535);
+
+    Inspectable<LineElements, uint32_t> lines32;
+    lines32.add(lines);
+    ASSERT_EQ(2, lines32.index());
+    EXPECT_EQ(0u, lines32.get(0)[0]);
+    EXPECT_EQ(1u, lines32.get(0)[1]);
+    EXPECT_EQ(65534u, lines32.get(1)[0]);
+    EXPECT_EQ(65535u, lines32.get(1)[1]);
+}
+
+TEST(ElementsBuffer, Expand) {
+    ExpandableElementsBuffer<TriangleElements> triangles;
+    triangles.add(0, 1, 2);
+    EXPECT_EQ(GLenum(GL_UNSIGNED_SHORT), triangles.type());
+    EXPECT_EQ(6u, triangles.itemSize());
+
+    if (!triangles.expand()) {
+        // 32 bit indices aren't available; the bucket has to start a new group.
+        EXPECT_EQ(GLenum(GL_UNSIGNED_SHORT), triangles.type());
+        return;
+    }
+
+    triangles.add(65535, 65536, 65537);
+    EXPECT_EQ(GLenum(GL_UNSIGNED_INT), triangles.type());
+    EXPECT_EQ(12u, triangles.itemSize());
+    EXPECT_TRUE(triangles.expand());
+}
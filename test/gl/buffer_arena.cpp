@@ -0,0 +1,173 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/gl/buffer_arena.hpp>
+#include <mbgl/gl/gl_object_store.hpp>
+#include <mbgl/platform/default/headless_display.hpp>
+#include <mbgl/platform/default/headless_view.hpp>
+
+#include <algorithm>
+#include <vector>
+
+using namespace mbgl;
+using namespace mbgl::gl;
+
+namespace {
+
+class BufferArenaTest {
+public:
+    BufferArenaTest() {
+        view.activate();
+    }
+
+    ~BufferArenaTest() {
+        // The object store expects the arena to be gone before it is destroyed.
+        glObjectStore.performCleanup();
+        view.deactivate();
+    }
+
+    BufferArena::Range allocate(GLenum target, GLsizeiptr size) {
+        const std::vector<uint8_t> data(size);
+        return glObjectStore.getBufferArena().allocate(target, size, data.data(), glObjectStore);
+    }
+
+    void release(const BufferArena::Range& range) {
+        glObjectStore.getBufferArena().release(range);
+    }
+
+    std::shared_ptr<HeadlessDisplay> display = std::make_shared<HeadlessDisplay>();
+    HeadlessView view { display, 1 };
+    GLObjectStore glObjectStore;
+};
+
+bool isBuffer(GLuint buffer) {
+    return MBGL_CHECK_ERROR(glIsBuffer(buffer)) == GL_TRUE;
+}
+
+} // namespace
+
+TEST(BufferArena, AllocateRelease) {
+    BufferArenaTest test;
+
+    const auto a = test.allocate(GL_ARRAY_BUFFER, 100);
+    const auto b = test.allocate(GL_ARRAY_BUFFER, 100);
+    const auto c = test.allocate(GL_ELEMENT_ARRAY_BUFFER, 100);
+
+    // Ranges of the same target share a page; ranges are rounded up for alignment.
+    EXPECT_EQ(a.buffer, b.buffer);
+    EXPECT_EQ(0, a.offset);
+    EXPECT_EQ(112, a.size);
+    EXPECT_EQ(112, b.offset);
+
+    // Other targets get pages of their own.
+    EXPECT_NE(a.buffer, c.buffer);
+    EXPECT_EQ(0, c.offset);
+
+    EXPECT_FALSE(test.glObjectStore.getBufferArena().empty());
+    test.release(a);
+    test.release(b);
+    EXPECT_FALSE(test.glObjectStore.getBufferArena().empty());
+    test.release(c);
+    EXPECT_TRUE(test.glObjectStore.getBufferArena().empty());
+
+    // Empty data still gets a range, so that there is a buffer to bind.
+    const auto empty = test.allocate(GL_ARRAY_BUFFER, 0);
+    EXPECT_TRUE(bool(empty));
+    EXPECT_EQ(16, empty.size);
+    test.release(empty);
+}
+
+TEST(BufferArena, MergesFreeRanges) {
+    BufferArenaTest test;
+
+    const auto a = test.allocate(GL_ARRAY_BUFFER, 1024);
+    const auto b = test.allocate(GL_ARRAY_BUFFER, 1024);
+    const auto c = test.allocate(GL_ARRAY_BUFFER, 1024);
+    const auto d = test.allocate(GL_ARRAY_BUFFER, 1024);
+
+    // Freeing b, then a merges a with the following free range.
+    test.release(b);
+    test.release(a);
+    const auto ab = test.allocate(GL_ARRAY_BUFFER, 2048);
+    EXPECT_EQ(a.buffer, ab.buffer);
+    EXPECT_EQ(0, ab.offset);
+
+    // Freeing c, then d merges d with the preceding free range, and with the rest of the page.
+    test.release(c);
+    test.release(d);
+    const auto rest = test.allocate(GL_ARRAY_BUFFER, BufferArena::PageSize - 2048);
+    EXPECT_EQ(a.buffer, rest.buffer);
+    EXPECT_EQ(2048, rest.offset);
+
+    test.release(ab);
+    test.release(rest);
+}
+
+TEST(BufferArena, RetainsEmptyPages) {
+    BufferArenaTest test;
+
+    // Keeps the arena from being dropped by the cleanup.
+    const auto keep = test.allocate(GL_ELEMENT_ARRAY_BUFFER, 16);
+
+    // Fill more pages than are retained once empty.
+    std::vector<BufferArena::Range> ranges;
+    for (size_t i = 0; i < BufferArena::MaxEmptyPages + 1; i++) {
+        ranges.push_back(test.allocate(GL_ARRAY_BUFFER, BufferArena::PageSize));
+        EXPECT_EQ(0, ranges.back().offset);
+    }
+    for (const auto& range : ranges) {
+        test.release(range);
+    }
+
+    test.glObjectStore.performCleanup();
+
+    size_t retained = 0;
+    for (const auto& range : ranges) {
+        if (isBuffer(range.buffer)) {
+            retained++;
+        }
+    }
+    EXPECT_EQ(BufferArena::MaxEmptyPages, retained);
+
+    // New data goes into a retained page.
+    const auto reused = test.allocate(GL_ARRAY_BUFFER, 100);
+    EXPECT_TRUE(isBuffer(reused.buffer));
+    EXPECT_NE(ranges.end(), std::find_if(ranges.begin(), ranges.end(), [&] (const BufferArena::Range& range) {
+        return range.buffer == reused.buffer;
+    }));
+
+    test.release(reused);
+    test.release(keep);
+}
+
+TEST(BufferArena, AbandonsLargePages) {
+    BufferArenaTest test;
+
+    const auto keep = test.allocate(GL_ARRAY_BUFFER, 16);
+
+    // Data larger than a page gets a page of its own, which isn't kept for reuse.
+    const auto large = test.allocate(GL_ARRAY_BUFFER, BufferArena::PageSize + 1);
+    EXPECT_NE(keep.buffer, large.buffer);
+    test.release(large);
+
+    test.glObjectStore.performCleanup();
+    EXPECT_FALSE(isBuffer(large.buffer));
+    EXPECT_TRUE(isBuffer(keep.buffer));
+
+    test.release(keep);
+}
+
+TEST(BufferArena, DroppedOnCleanup) {
+    BufferArenaTest test;
+
+    const auto range = test.allocate(GL_ARRAY_BUFFER, 100);
+
+    // The arena isn't dropped while anything is allocated from it.
+    test.glObjectStore.performCleanup();
+    EXPECT_TRUE(isBuffer(range.buffer));
+
+    // Once it is empty, the cleanup drops the arena along with the pages it retains.
+    test.release(range);
+    EXPECT_TRUE(isBuffer(range.buffer));
+    test.glObjectStore.performCleanup();
+    EXPECT_FALSE(isBuffer(range.buffer));
+}
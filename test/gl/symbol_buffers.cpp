@@ -0,0 +1,99 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/geometry/elements_buffer.hpp>
+#include <mbgl/geometry/icon_buffer.hpp>
+#include <mbgl/geometry/text_buffer.hpp>
+#include <mbgl/gl/gl_object_store.hpp>
+#include <mbgl/platform/default/headless_display.hpp>
+#include <mbgl/platform/default/headless_view.hpp>
+
+using namespace mbgl;
+
+namespace {
+
+class SymbolBuffersTest {
+public:
+    SymbolBuffersTest() {
+        view.activate();
+    }
+
+    ~SymbolBuffersTest() {
+        glObjectStore.performCleanup();
+        view.deactivate();
+    }
+
+    std::shared_ptr<HeadlessDisplay> display = std::make_shared<HeadlessDisplay>();
+    HeadlessView view { display, 1 };
+    gl::GLObjectStore glObjectStore;
+};
+
+class InspectableQuadElementsBuffer : public QuadElementsBuffer {
+public:
+    const element_type* triangle(GLsizei i) {
+        return static_cast<const element_type*>(getElement(i));
+    }
+};
+
+// Adds a glyph quad the way SymbolBucket::addSymbols does.
+void addQuad(TextVertexBuffer& vertices, int16_t x, int16_t y) {
+    vertices.add(x, y, -4, -4, 0, 0, 0, 25, 0);
+    vertices.add(x, y, 4, -4, 8, 0, 0, 25, 0);
+    vertices.add(x, y, -4, 4, 0, 8, 0, 25, 0);
+    vertices.add(x, y, 4, 4, 8, 8, 0, 25, 0);
+}
+
+} // namespace
+
+TEST(SymbolBuffers, VertexStride) {
+    // Position, offset, texture coordinates and the three zoom levels: 13 bytes of payload,
+    // padded to the 4 byte alignment of vertex attributes.
+    EXPECT_EQ(16u, size_t(TextVertexBuffer::itemSize));
+    EXPECT_EQ(16u, size_t(IconVertexBuffer::itemSize));
+}
+
+TEST(SymbolBuffers, QuadIndices) {
+    InspectableQuadElementsBuffer quads;
+
+    // Two triangles for every quad of a group of 65536 vertices.
+    ASSERT_EQ(2 * QuadElementsBuffer::maxQuads, quads.index());
+    EXPECT_LE(65535, QuadElementsBuffer::maxQuads * 4 - 1);
+
+    for (GLsizei i = 0; i < QuadElementsBuffer::maxQuads; i++) {
+        const uint16_t vertex = i * 4;
+        const uint16_t* first = quads.triangle(i * 2);
+        const uint16_t* second = quads.triangle(i * 2 + 1);
+        ASSERT_EQ(vertex + 0, first[0]);
+        ASSERT_EQ(vertex + 1, first[1]);
+        ASSERT_EQ(vertex + 2, first[2]);
+        ASSERT_EQ(vertex + 1, second[0]);
+        ASSERT_EQ(vertex + 2, second[1]);
+        ASSERT_EQ(vertex + 3, second[2]);
+    }
+
+    // The last quad ends at the last vertex that 16 bit indices can address.
+    EXPECT_EQ(65535, quads.triangle(quads.index() - 1)[2]);
+}
+
+TEST(SymbolBuffers, UploadedBytes) {
+    SymbolBuffersTest test;
+    auto& counters = test.glObjectStore.counters;
+
+    // The indices are uploaded once, and shared by all symbol buckets.
+    QuadElementsBuffer quads;
+    quads.upload(test.glObjectStore);
+    EXPECT_EQ(uint64_t(QuadElementsBuffer::maxQuads) * 2 * 6, counters.bytesUploaded);
+
+    // A bucket then only uploads its vertices: 16 bytes per vertex, 64 per glyph.
+    const int glyphs = 1000;
+    for (int bucket = 0; bucket < 2; bucket++) {
+        const uint64_t before = counters.bytesUploaded;
+
+        TextVertexBuffer vertices;
+        for (int i = 0; i < glyphs; i++) {
+            addQuad(vertices, i, bucket);
+        }
+        vertices.upload(test.glObjectStore);
+
+        EXPECT_EQ(uint64_t(glyphs) * 4 * 16, counters.bytesUploaded - before);
+    }
+}
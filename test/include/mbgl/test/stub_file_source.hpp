@@ -15,6 +15,9 @@ public:
 
     std::unique_ptr<AsyncRequest> request(const Resource&, Callback) override;
 
+    // Updates the resource that is passed to the response callbacks.
+    void setPriority(AsyncRequest&, Resource::Priority) override;
+
     using ResponseFunction = std::function<optional<Response> (const Resource&)>;
 
     // You can set the response callback on a global level by assigning this callback:
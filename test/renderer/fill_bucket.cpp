@@ -0,0 +1,62 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/renderer/fill_bucket.hpp>
+#include <mbgl/util/constants.hpp>
+
+using namespace mbgl;
+
+namespace {
+
+GeometryCoordinates rectangle(int16_t left, int16_t top, int16_t right, int16_t bottom) {
+    return {{ left, top }, { right, top }, { right, bottom }, { left, bottom }, { left, top }};
+}
+
+const int16_t extent = util::EXTENT;
+
+} // namespace
+
+TEST(FillBucket, CoversTile) {
+    FillBucket bucket;
+    bucket.addGeometry({ rectangle(-64, -64, extent + 64, extent + 64) });
+    EXPECT_TRUE(bucket.coversTile());
+}
+
+TEST(FillBucket, CoversTileExactly) {
+    FillBucket bucket;
+    bucket.addGeometry({ rectangle(0, 0, extent, extent) });
+    EXPECT_TRUE(bucket.coversTile());
+}
+
+TEST(FillBucket, CoversTileWithHole) {
+    FillBucket bucket;
+    bucket.addGeometry({
+        rectangle(-64, -64, extent + 64, extent + 64),
+        rectangle(1024, 1024, 2048, 2048)
+    });
+    EXPECT_FALSE(bucket.coversTile());
+}
+
+TEST(FillBucket, CoversTilePartially) {
+    FillBucket bucket;
+
+    // Extends beyond three of the four tile edges.
+    bucket.addGeometry({ rectangle(-64, -64, extent + 64, extent - 64) });
+    EXPECT_FALSE(bucket.coversTile());
+
+    // Extends beyond all tile edges, but leaves out a corner.
+    bucket.addGeometry({{
+        { -64, -64 }, { extent + 64, -64 }, { extent + 64, extent / 2 },
+        { extent / 2, extent + 64 }, { -64, extent + 64 }, { -64, -64 }
+    }});
+    EXPECT_FALSE(bucket.coversTile());
+}
+
+TEST(FillBucket, CoversTileOnceCovered) {
+    FillBucket bucket;
+    bucket.addGeometry({ rectangle(0, 0, extent / 2, extent / 2) });
+    EXPECT_FALSE(bucket.coversTile());
+
+    // A later feature that covers the tile by itself covers it regardless of the others.
+    bucket.addGeometry({ rectangle(-64, -64, extent + 64, extent + 64) });
+    EXPECT_TRUE(bucket.coversTile());
+}
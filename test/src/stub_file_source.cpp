@@ -38,6 +38,13 @@ std::unique_ptr<AsyncRequest> StubFileSource::request(const Resource& resource,
     return std::move(req);
 }
 
+void StubFileSource::setPriority(AsyncRequest& req, Resource::Priority priority) {
+    auto it = pending.find(&req);
+    if (it != pending.end()) {
+        std::get<0>(it->second).priority = priority;
+    }
+}
+
 optional<Response> StubFileSource::defaultResponse(const Resource& resource) {
     switch (resource.kind) {
     case Resource::Kind::Style:
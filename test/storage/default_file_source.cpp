@@ -97,6 +97,53 @@ TEST_F(DefaultFileSourceTest, TEST_REQUIRES_SERVER(CacheRevalidateSame)) {
     loop.run();
 }
 
+TEST_F(DefaultFileSourceTest, TEST_REQUIRES_SERVER(CacheRevalidateSameLateRequest)) {
+    SCOPED_TEST(CacheRevalidateSameLateRequest)
+
+    using namespace mbgl;
+
+    util::RunLoop loop;
+    DefaultFileSource fs(":memory:", ".");
+
+    const Resource revalidateSame { Resource::Unknown, "http://127.0.0.1:3000/revalidate-same" };
+    std::unique_ptr<AsyncRequest> req1;
+    std::unique_ptr<AsyncRequest> req2;
+    std::unique_ptr<AsyncRequest> req3;
+    uint16_t counter = 0;
+
+    // First request causes the response to get cached.
+    req1 = fs.request(revalidateSame, [&](Response res) {
+        req1.reset();
+        ASSERT_TRUE(res.data.get());
+
+        // Second request returns the cached response, then revalidates it with a 304.
+        req2 = fs.request(revalidateSame, [&](Response res2) {
+            if (counter++ == 0) {
+                ASSERT_TRUE(res2.data.get());
+                return;
+            }
+            EXPECT_TRUE(res2.notModified);
+
+            // A request made while the second one is still alive must still get the data.
+            req3 = fs.request(revalidateSame, [&](Response res3) {
+                req2.reset();
+                req3.reset();
+
+                EXPECT_EQ(nullptr, res3.error);
+                EXPECT_FALSE(res3.notModified);
+                ASSERT_TRUE(res3.data.get());
+                EXPECT_EQ("Response", *res3.data);
+                EXPECT_EQ("snowfall", *res3.etag);
+
+                loop.stop();
+                CacheRevalidateSameLateRequest.finish();
+            });
+        });
+    });
+
+    loop.run();
+}
+
 TEST_F(DefaultFileSourceTest, TEST_REQUIRES_SERVER(CacheRevalidateModified)) {
     SCOPED_TEST(CacheRevalidateModified)
 
@@ -194,3 +241,36 @@ TEST_F(DefaultFileSourceTest, TEST_REQUIRES_SERVER(CacheRevalidateEtag)) {
 
     loop.run();
 }
+
+TEST_F(DefaultFileSourceTest, TEST_REQUIRES_SERVER(CoalesceRequests)) {
+    SCOPED_TEST(CoalesceRequests)
+
+    using namespace mbgl;
+
+    util::RunLoop loop;
+    DefaultFileSource fs(":memory:", ".");
+
+    const Resource resource { Resource::Unknown, "http://127.0.0.1:3000/coalesce" };
+    std::unique_ptr<AsyncRequest> req1;
+    std::unique_ptr<AsyncRequest> req2;
+    int completed = 0;
+
+    // Both requests are in flight at the same time, so they share a single request to the
+    // server, which would respond with "Response 2" to a second one.
+    auto callback = [&](std::unique_ptr<AsyncRequest>& req, Response res) {
+        req.reset();
+        EXPECT_EQ(nullptr, res.error);
+        ASSERT_TRUE(res.data.get());
+        EXPECT_EQ("Response 1", *res.data);
+
+        if (++completed == 2) {
+            loop.stop();
+            CoalesceRequests.finish();
+        }
+    };
+
+    req1 = fs.request(resource, [&](Response res) { callback(req1, res); });
+    req2 = fs.request(resource, [&](Response res) { callback(req2, res); });
+
+    loop.run();
+}
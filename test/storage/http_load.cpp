@@ -4,6 +4,10 @@
 #include <mbgl/util/chrono.hpp>
 #include <mbgl/util/run_loop.hpp>
 
+#include <algorithm>
+#include <string>
+#include <vector>
+
 TEST_F(Storage, TEST_REQUIRES_SERVER(HTTPLoad)) {
     SCOPED_TEST(HTTPLoad)
 
@@ -47,3 +51,107 @@ TEST_F(Storage, TEST_REQUIRES_SERVER(HTTPLoad)) {
 
     loop.run();
 }
+
+namespace {
+
+// Issues a batch of requests that the server holds for a while, alternating between the
+// given hosts, and returns the highest number of them that the server saw in flight at the
+// same time.
+int peakConcurrency(uint32_t maximumRequests, uint32_t maximumConnectionsPerHost,
+                    std::vector<std::string> hosts = { "http://127.0.0.1:3000" }) {
+    using namespace mbgl;
+
+    util::RunLoop loop;
+    OnlineFileSource fs;
+    fs.setMaximumConcurrentRequests(maximumRequests);
+    fs.setMaximumConnectionsPerHost(maximumConnectionsPerHost);
+
+    const int concurrency = 20;
+    int completed = 0;
+    int peak = 0;
+
+    std::unique_ptr<AsyncRequest> reqs[concurrency];
+
+    for (int i = 0; i < concurrency; i++) {
+        reqs[i] = fs.request({ Resource::Unknown,
+                     hosts[i % hosts.size()] + "/concurrent/" + std::to_string(i) },
+                   [&, i](Response res) {
+            reqs[i].reset();
+            EXPECT_EQ(nullptr, res.error);
+            if (res.data) {
+                peak = std::max(peak, std::stoi(*res.data));
+            }
+
+            if (++completed == concurrency) {
+                loop.stop();
+            }
+        });
+    }
+
+    loop.run();
+
+    return peak;
+}
+
+} // namespace
+
+TEST_F(Storage, TEST_REQUIRES_SERVER(HTTPLoadLimitedConcurrency)) {
+    SCOPED_TEST(HTTPLoadLimitedConcurrency)
+
+    // The request limit applies when the host would accept more connections...
+    EXPECT_EQ(2, peakConcurrency(2, 6));
+
+    // ...and the host limit when there are more requests allowed in flight...
+    EXPECT_EQ(1, peakConcurrency(4, 1));
+
+    // ...without holding up requests for other hosts.
+    EXPECT_EQ(2, peakConcurrency(4, 1, { "http://127.0.0.1:3000", "http://localhost:3000" }));
+
+    HTTPLoadLimitedConcurrency.finish();
+}
+
+TEST_F(Storage, TEST_REQUIRES_SERVER(HTTPLoadPriority)) {
+    SCOPED_TEST(HTTPLoadPriority)
+
+    using namespace mbgl;
+
+    util::RunLoop loop;
+    OnlineFileSource fs;
+    fs.setMaximumConcurrentRequests(1);
+
+    // The first request takes the only slot; the rest are queued and should be dispatched by
+    // priority, in request order within a priority. The second prefetch gets promoted before
+    // it is queued.
+    const Resource::Priority priorities[] = {
+        Resource::Priority::Regular,
+        Resource::Priority::Low,
+        Resource::Priority::Low,
+        Resource::Priority::Regular,
+        Resource::Priority::High,
+    };
+    const int count = 5;
+    const std::vector<int> expected = { 0, 2, 4, 3, 1 };
+    std::vector<int> completed;
+
+    std::unique_ptr<AsyncRequest> reqs[count];
+
+    for (int i = 0; i < count; i++) {
+        Resource resource { Resource::Unknown, std::string("http://127.0.0.1:3000/load/") + std::to_string(i) };
+        resource.priority = priorities[i];
+        reqs[i] = fs.request(resource, [&, i](Response res) {
+            reqs[i].reset();
+            EXPECT_EQ(nullptr, res.error);
+            completed.push_back(i);
+
+            if (completed.size() == size_t(count)) {
+                EXPECT_EQ(expected, completed);
+                loop.stop();
+                HTTPLoadPriority.finish();
+            }
+        });
+    }
+
+    fs.setPriority(*reqs[2], Resource::Priority::High);
+
+    loop.run();
+}
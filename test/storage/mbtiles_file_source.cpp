@@ -0,0 +1,117 @@
+#include <mbgl/storage/mbtiles_file_source.hpp>
+#include <mbgl/storage/resource.hpp>
+#include <mbgl/util/run_loop.hpp>
+
+#include <gtest/gtest.h>
+
+#include <climits>
+#include <unistd.h>
+
+using namespace mbgl;
+
+// MBTiles URLs contain an absolute path.
+static std::string archiveURL() {
+    char cwd[PATH_MAX];
+    EXPECT_NE(nullptr, getcwd(cwd, sizeof(cwd)));
+    return std::string("mbtiles://") + cwd + "/test/fixtures/storage/sample.mbtiles";
+}
+
+static const std::string archive = archiveURL();
+
+TEST(MBTilesFileSource, AcceptsURL) {
+    EXPECT_TRUE(MBTilesFileSource::acceptsURL("mbtiles:///data/archive.mbtiles"));
+    EXPECT_FALSE(MBTilesFileSource::acceptsURL("asset://archive.mbtiles"));
+    EXPECT_FALSE(MBTilesFileSource::acceptsURL("http://example.com/archive.mbtiles"));
+}
+
+TEST(MBTilesFileSource, Tile) {
+    util::RunLoop loop;
+    MBTilesFileSource fs;
+
+    std::unique_ptr<AsyncRequest> req = fs.request(Resource::tile(archive, 1.0, 0, 0, 0), [&](Response res) {
+        req.reset();
+        EXPECT_EQ(nullptr, res.error);
+        ASSERT_TRUE(res.data.get());
+        EXPECT_EQ("plain tile", *res.data);
+        loop.stop();
+    });
+
+    loop.run();
+}
+
+TEST(MBTilesFileSource, CompressedTile) {
+    util::RunLoop loop;
+    MBTilesFileSource fs;
+
+    // Stored with TMS row 1, i.e. XYZ row 0.
+    std::unique_ptr<AsyncRequest> req = fs.request(Resource::tile(archive, 1.0, 0, 0, 1), [&](Response res) {
+        req.reset();
+        EXPECT_EQ(nullptr, res.error);
+        ASSERT_TRUE(res.data.get());
+        EXPECT_EQ("compressed tile", *res.data);
+        loop.stop();
+    });
+
+    loop.run();
+}
+
+TEST(MBTilesFileSource, MissingTile) {
+    util::RunLoop loop;
+    MBTilesFileSource fs;
+
+    std::unique_ptr<AsyncRequest> req = fs.request(Resource::tile(archive, 1.0, 1, 1, 1), [&](Response res) {
+        req.reset();
+        EXPECT_EQ(nullptr, res.error);
+        EXPECT_TRUE(res.noContent);
+        EXPECT_FALSE(res.data.get());
+        loop.stop();
+    });
+
+    loop.run();
+}
+
+TEST(MBTilesFileSource, TileJSON) {
+    util::RunLoop loop;
+    MBTilesFileSource fs;
+
+    std::unique_ptr<AsyncRequest> req = fs.request(Resource::source(archive), [&](Response res) {
+        req.reset();
+        EXPECT_EQ(nullptr, res.error);
+        ASSERT_TRUE(res.data.get());
+        EXPECT_EQ(R"({"tilejson":"2.1.0","tiles":[")" + archive + R"("],)"
+                  R"("minzoom":0,"maxzoom":1,"bounds":[-180.0,-85.0,180.0,85.0]})", *res.data);
+        loop.stop();
+    });
+
+    loop.run();
+}
+
+TEST(MBTilesFileSource, NonExistentArchive) {
+    util::RunLoop loop;
+    MBTilesFileSource fs;
+
+    std::unique_ptr<AsyncRequest> req = fs.request(Resource::tile("mbtiles:///does/not/exist.mbtiles", 1.0, 0, 0, 0), [&](Response res) {
+        req.reset();
+        ASSERT_NE(nullptr, res.error);
+        EXPECT_EQ(Response::Error::Reason::NotFound, res.error->reason);
+        loop.stop();
+    });
+
+    loop.run();
+}
+
+TEST(MBTilesFileSource, MalformedURL) {
+    util::RunLoop loop;
+    MBTilesFileSource fs;
+
+    // A relative path would be read as the URL's host.
+    std::unique_ptr<AsyncRequest> req = fs.request(Resource::tile("mbtiles://test/fixtures/storage/sample.mbtiles", 1.0, 0, 0, 0), [&](Response res) {
+        req.reset();
+        ASSERT_NE(nullptr, res.error);
+        EXPECT_EQ(Response::Error::Reason::Other, res.error->reason);
+        EXPECT_FALSE(res.data.get());
+        loop.stop();
+    });
+
+    loop.run();
+}
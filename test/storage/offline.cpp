@@ -71,3 +71,13 @@ TEST(OfflineTilePyramidRegionDefinition, TileCoverWrapped) {
     ASSERT_EQ(0, result[0].x);
     ASSERT_EQ(0, result[0].y);
 }
+
+TEST(OfflineTilePyramidRegionDefinition, TileCount) {
+    OfflineTilePyramidRegionDefinition region("", sanFrancisco, 0, 16, 1.0);
+    SourceInfo info;
+
+    EXPECT_EQ(region.tileCover(SourceType::Vector, 512, info).size(),
+              region.tileCount(SourceType::Vector, 512, info));
+    EXPECT_EQ(region.tileCover(SourceType::Raster, 256, info).size(),
+              region.tileCount(SourceType::Raster, 256, info));
+}
@@ -654,3 +654,31 @@ TEST(OfflineDatabase, OfflineMapboxTileCount) {
     db.deleteRegion(std::move(region1));
     EXPECT_EQ(0, db.getOfflineMapboxTileCount());
 }
+
+TEST(OfflineDatabase, HasRegionResources) {
+    using namespace mbgl;
+
+    OfflineDatabase db(":memory:");
+    OfflineRegionDefinition definition { "http://example.com/style", LatLngBounds::hull({1, 2}, {3, 4}), 5, 6, 2.0 };
+    OfflineRegion region = db.createRegion(definition, OfflineRegionMetadata());
+
+    Resource style = Resource::style("http://example.com/style");
+    Resource tile = Resource::tile("http://example.com/{z}-{x}-{y}", 1.0, 0, 0, 0);
+    Resource missing = Resource::tile("http://example.com/{z}-{x}-{y}", 1.0, 0, 0, 1);
+
+    Response response;
+    response.data = randomString(1024);
+    db.put(style, response);
+    db.put(tile, response);
+
+    auto result = db.hasRegionResources(region.getID(), { style, tile, missing });
+    ASSERT_EQ(3, result.size());
+    EXPECT_EQ(1024, *result[0]);
+    EXPECT_EQ(1024, *result[1]);
+    EXPECT_FALSE(bool(result[2]));
+
+    // Present resources are now counted towards the region.
+    OfflineRegionStatus status = db.getRegionCompletedStatus(region.getID());
+    EXPECT_EQ(2, status.completedResourceCount);
+    EXPECT_EQ(2048, status.completedResourceSize);
+}
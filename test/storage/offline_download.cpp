@@ -3,12 +3,14 @@
 #include <mbgl/storage/offline.hpp>
 #include <mbgl/storage/offline_database.hpp>
 #include <mbgl/storage/offline_download.hpp>
+#include <mbgl/storage/http_context_base.hpp>
 #include <mbgl/util/run_loop.hpp>
 #include <mbgl/util/io.hpp>
 #include <mbgl/util/compression.hpp>
 #include <mbgl/util/string.hpp>
 
 #include <gtest/gtest.h>
+#include <algorithm>
 #include <iostream>
 
 using namespace mbgl;
@@ -33,6 +35,36 @@ public:
     std::function<void (uint64_t)> mapboxTileCountLimitExceededFn;
 };
 
+// Forwards requests to a StubFileSource and keeps track of how many are in flight.
+class CountingFileSource : public FileSource {
+public:
+    CountingFileSource(FileSource& fileSource_)
+        : fileSource(fileSource_) {}
+
+    std::unique_ptr<AsyncRequest> request(const Resource& resource, Callback callback) override {
+        class CountingRequest : public AsyncRequest {
+        public:
+            CountingRequest(CountingFileSource& source_, std::unique_ptr<AsyncRequest> request_)
+                : source(source_), request(std::move(request_)) {
+                source.peak = std::max(source.peak, ++source.inFlight);
+            }
+
+            ~CountingRequest() override {
+                source.inFlight--;
+            }
+
+            CountingFileSource& source;
+            std::unique_ptr<AsyncRequest> request;
+        };
+
+        return std::make_unique<CountingRequest>(*this, fileSource.request(resource, callback));
+    }
+
+    FileSource& fileSource;
+    std::size_t inFlight = 0;
+    std::size_t peak = 0;
+};
+
 class OfflineTest {
 public:
     util::RunLoop loop;
@@ -533,3 +565,145 @@ TEST(OfflineDownload, Deactivate) {
 
     test.loop.run();
 }
+
+TEST(OfflineDownload, RequestWindow) {
+    OfflineTest test;
+    OfflineRegion region = test.createRegion();
+    CountingFileSource fileSource(test.fileSource);
+    OfflineDownload download(
+        region.getID(),
+        OfflineTilePyramidRegionDefinition("http://127.0.0.1:3000/offline/style.json", LatLngBounds::world(), 0.0, 3.0, 1.0),
+        test.db, fileSource);
+
+    const std::size_t maximum = HTTPContextBase::maximumConcurrentRequests();
+
+    test.fileSource.styleResponse = [&] (const Resource&) {
+        return test.response("offline/inline_source.style.json");
+    };
+
+    // Hold back the tiles until the request window is full, so that the download has to
+    // wait for room before requesting more of them.
+    bool windowFilled = false;
+    test.fileSource.tileResponse = [&] (const Resource&) -> optional<Response> {
+        if (!windowFilled) {
+            if (fileSource.inFlight < maximum) {
+                return {};
+            }
+            windowFilled = true;
+        }
+        return test.response("offline/0-0-0.vector.pbf");
+    };
+
+    auto observer = std::make_unique<MockObserver>();
+
+    observer->statusChangedFn = [&] (OfflineRegionStatus status) {
+        EXPECT_LE(fileSource.inFlight, maximum);
+        if (status.complete()) {
+            EXPECT_LT(maximum, status.requiredResourceCount);
+            EXPECT_EQ(status.requiredResourceCount, status.completedResourceCount);
+            EXPECT_EQ(test.size, status.completedResourceSize);
+            test.loop.stop();
+        }
+    };
+
+    download.setObserver(std::move(observer));
+    download.setState(OfflineRegionDownloadState::Active);
+
+    test.loop.run();
+
+    EXPECT_TRUE(windowFilled);
+    EXPECT_EQ(maximum, fileSource.peak);
+}
+
+TEST(OfflineDownload, RequestWindowConfigured) {
+    OfflineTest test;
+    OfflineRegion region = test.createRegion();
+    CountingFileSource fileSource(test.fileSource);
+    OfflineDownload download(
+        region.getID(),
+        OfflineTilePyramidRegionDefinition("http://127.0.0.1:3000/offline/style.json", LatLngBounds::world(), 0.0, 3.0, 1.0),
+        test.db, fileSource);
+
+    const std::size_t maximum = 2;
+    download.setMaximumConcurrentRequests(maximum);
+
+    test.fileSource.styleResponse = [&] (const Resource&) {
+        return test.response("offline/inline_source.style.json");
+    };
+
+    test.fileSource.tileResponse = [&] (const Resource&) {
+        return test.response("offline/0-0-0.vector.pbf");
+    };
+
+    auto observer = std::make_unique<MockObserver>();
+
+    observer->statusChangedFn = [&] (OfflineRegionStatus status) {
+        EXPECT_LE(fileSource.inFlight, maximum);
+        if (status.complete()) {
+            test.loop.stop();
+        }
+    };
+
+    download.setObserver(std::move(observer));
+    download.setState(OfflineRegionDownloadState::Active);
+
+    test.loop.run();
+
+    EXPECT_EQ(maximum, fileSource.peak);
+}
+
+TEST(OfflineDownload, DownloadRate) {
+    OfflineTest test;
+    OfflineRegion region = test.createRegion();
+    const OfflineTilePyramidRegionDefinition definition(
+        "http://127.0.0.1:3000/offline/style.json", LatLngBounds::world(), 0.0, 0.0, 1.0);
+
+    test.fileSource.styleResponse = [&] (const Resource&) {
+        return test.response("offline/inline_source.style.json");
+    };
+
+    test.fileSource.tileResponse = [&] (const Resource&) {
+        return test.response("offline/0-0-0.vector.pbf");
+    };
+
+    OfflineRegionStatus downloaded;
+    auto observer = std::make_unique<MockObserver>();
+    observer->statusChangedFn = [&] (OfflineRegionStatus status) {
+        if (status.complete()) {
+            downloaded = status;
+            test.loop.stop();
+        }
+    };
+
+    const TimePoint start = Clock::now();
+
+    OfflineDownload download(region.getID(), OfflineRegionDefinition(definition), test.db, test.fileSource);
+    download.setObserver(std::move(observer));
+    download.setState(OfflineRegionDownloadState::Active);
+
+    test.loop.run();
+
+    // The rate averages the downloaded bytes over the time since the download was activated.
+    const double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+    EXPECT_GT(downloaded.downloadRate, 0);
+    EXPECT_GE(downloaded.downloadRate, test.size / elapsed);
+
+    // Resources that are already in the database don't count as downloaded.
+    OfflineRegionStatus reactivated;
+    observer = std::make_unique<MockObserver>();
+    observer->statusChangedFn = [&] (OfflineRegionStatus status) {
+        if (status.complete()) {
+            reactivated = status;
+            test.loop.stop();
+        }
+    };
+
+    OfflineDownload redownload(region.getID(), OfflineRegionDefinition(definition), test.db, test.fileSource);
+    redownload.setObserver(std::move(observer));
+    redownload.setState(OfflineRegionDownloadState::Active);
+
+    test.loop.run();
+
+    EXPECT_EQ(downloaded.completedResourceCount, reactivated.completedResourceCount);
+    EXPECT_EQ(0, reactivated.downloadRate);
+}
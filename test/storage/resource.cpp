@@ -58,3 +58,14 @@ TEST(Resource, SpriteJSON) {
     EXPECT_EQ(Resource::Kind::SpriteJSON, resource.kind);
     EXPECT_EQ("http://example.com/sprite@2x.json", resource.url);
 }
+
+TEST(Resource, Priority) {
+    using namespace mbgl;
+    EXPECT_EQ(Resource::Priority::High, Resource::style("http://example.com").priority);
+    EXPECT_EQ(Resource::Priority::High, Resource::source("http://example.com").priority);
+    EXPECT_EQ(Resource::Priority::High, Resource::glyphs("http://example.com", "Open Sans", { 0, 255 }).priority);
+    EXPECT_EQ(Resource::Priority::High, Resource::spriteImage("http://example.com/sprite", 1.0).priority);
+    EXPECT_EQ(Resource::Priority::High, Resource::spriteJSON("http://example.com/sprite", 1.0).priority);
+    EXPECT_EQ(Resource::Priority::Regular, Resource::tile("http://example.com/{z}/{x}/{y}.mvt", 1.0, 0, 0, 0).priority);
+    EXPECT_EQ(Resource::Priority::Regular, Resource(Resource::Unknown, "http://example.com").priority);
+}
@@ -42,6 +42,12 @@ app.get('/cache', function(req, res) {
     res.send('Response ' + (++cacheCounter));
 });
 
+var coalesceCounter = 0;
+app.get('/coalesce', function(req, res) {
+    res.setHeader('Cache-Control', 'max-age=30');
+    res.send('Response ' + (++coalesceCounter));
+});
+
 app.get('/revalidate-same', function(req, res) {
     if (req.headers['if-none-match'] == 'snowfall') {
         // Second request can be cached for 30 seconds.
@@ -127,6 +133,22 @@ app.get('/load/:number(\\d+)', function(req, res) {
     res.send('Request ' + req.params.number);
 });
 
+// Holds each request for a while and responds with the highest number of requests that
+// were in flight at the same time while it was.
+var concurrentRequests = [];
+app.get('/concurrent/:number(\\d+)', function(req, res) {
+    var request = { peak: 0 };
+    concurrentRequests.push(request);
+    concurrentRequests.forEach(function(other) {
+        other.peak = Math.max(other.peak, concurrentRequests.length);
+    });
+
+    setTimeout(function() {
+        concurrentRequests.splice(concurrentRequests.indexOf(request), 1);
+        res.send(String(request.peak));
+    }, 50);
+});
+
 var server = app.listen(3000, function () {
     // Tell parent that we're now listening.
     process.stdout.write("OK");
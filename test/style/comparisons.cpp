@@ -4,6 +4,7 @@
 #include <mbgl/tile/vector_tile.hpp>
 #include <mbgl/style/filter_expression.hpp>
 #include <mbgl/style/filter_expression_private.hpp>
+#include <mbgl/style/compiled_filter.hpp>
 
 #include <map>
 
@@ -16,6 +17,7 @@ public:
     inline Extractor(const Properties& properties_, FeatureType type_)
         : properties(properties_)
         , type(type_)
+        , typeValue(uint64_t(type_))
     {}
 
     optional<Value> getValue(const std::string &key) const {
@@ -27,6 +29,15 @@ public:
         return it->second;
     }
 
+    const Value* findValue(const std::string &key) const {
+        if (key == "$type")
+            return &typeValue;
+        auto it = properties.find(key);
+        if (it == properties.end())
+            return nullptr;
+        return &it->second;
+    }
+
     FeatureType getType() const {
         return type;
     }
@@ -34,6 +45,7 @@ public:
 private:
     const Properties properties;
     FeatureType type;
+    const Value typeValue;
 };
 
 FilterExpression parse(const char * expression) {
@@ -43,7 +55,10 @@ FilterExpression parse(const char * expression) {
 }
 
 bool evaluate(const FilterExpression& expression, const Properties& properties, FeatureType type = FeatureType::Unknown) {
-    return mbgl::evaluate(expression, Extractor(properties, type));
+    const Extractor extractor(properties, type);
+    const bool result = mbgl::evaluate(expression, extractor);
+    EXPECT_EQ(result, CompiledFilter(expression).evaluate(extractor));
+    return result;
 }
 
 TEST(FilterComparison, EqualsString) {
@@ -108,3 +123,50 @@ TEST(FilterComparison, None) {
     ASSERT_FALSE(evaluate(parse("[\"none\", [\"==\", \"foo\", 0], [\"==\", \"foo\", 1]]"),
                           {{ std::string("foo"), int64_t(1) }}));
 }
+
+TEST(FilterComparison, In) {
+    FilterExpression f = parse("[\"in\", \"foo\", \"bar\", 1, true]");
+    ASSERT_TRUE(evaluate(f, {{ "foo", std::string("bar") }}));
+    ASSERT_TRUE(evaluate(f, {{ "foo", int64_t(1) }}));
+    ASSERT_TRUE(evaluate(f, {{ "foo", uint64_t(1) }}));
+    ASSERT_TRUE(evaluate(f, {{ "foo", double(1) }}));
+    ASSERT_TRUE(evaluate(f, {{ "foo", true }}));
+    ASSERT_FALSE(evaluate(f, {{ "foo", false }}));
+    ASSERT_FALSE(evaluate(f, {{ "foo", std::string("1") }}));
+    ASSERT_FALSE(evaluate(f, {{ "foo", double(1.5) }}));
+    ASSERT_FALSE(evaluate(f, {{}}));
+}
+
+TEST(FilterComparison, NotIn) {
+    FilterExpression f = parse("[\"!in\", \"foo\", \"bar\", 1]");
+    ASSERT_FALSE(evaluate(f, {{ "foo", std::string("bar") }}));
+    ASSERT_FALSE(evaluate(f, {{ "foo", double(1) }}));
+    ASSERT_TRUE(evaluate(f, {{ "foo", std::string("baz") }}));
+    ASSERT_TRUE(evaluate(f, {{ "foo", int64_t(2) }}));
+    ASSERT_TRUE(evaluate(f, {{}}));
+}
+
+TEST(FilterComparison, CompiledKeyLookup) {
+    class CountingExtractor : public Extractor {
+    public:
+        using Extractor::Extractor;
+
+        const Value* findValue(const std::string& key) const {
+            lookups++;
+            return Extractor::findValue(key);
+        }
+
+        mutable int lookups = 0;
+    };
+
+    CompiledFilter filter(parse("[\"all\", [\">=\", \"foo\", 1], [\"<\", \"foo\", 5], [\"!=\", \"foo\", 3]]"));
+    CompiledFilter::Scratch scratch;
+
+    CountingExtractor matching({{ "foo", int64_t(2) }}, FeatureType::Unknown);
+    ASSERT_TRUE(filter.evaluate(matching, scratch));
+    ASSERT_EQ(1, matching.lookups);
+
+    CountingExtractor excluded({{ "foo", int64_t(3) }}, FeatureType::Unknown);
+    ASSERT_FALSE(filter.evaluate(excluded, scratch));
+    ASSERT_EQ(1, excluded.lookups);
+}
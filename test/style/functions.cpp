@@ -1,7 +1,10 @@
 #include <iostream>
+#include <unordered_map>
 #include <mbgl/test/util.hpp>
 
 #include <mbgl/style/function.hpp>
+#include <mbgl/style/property_function.hpp>
+#include <mbgl/style/property_parsing.hpp>
 #include <mbgl/style/style_calculation_parameters.hpp>
 
 using namespace mbgl;
@@ -57,3 +60,74 @@ TEST(Function, Stops) {
     EXPECT_EQ(4.75, slope_4.evaluate(StyleCalculationParameters(2.75)));
     EXPECT_EQ(10, slope_4.evaluate(StyleCalculationParameters(8)));
 }
+
+TEST(Function, UnsortedStops) {
+    mbgl::Function<float> function({ { 8, 10 }, { 0, 2 }, { 4, 6 } }, 1);
+    EXPECT_EQ(2, function.evaluate(StyleCalculationParameters(-1)));
+    EXPECT_EQ(3, function.evaluate(StyleCalculationParameters(1)));
+    EXPECT_EQ(6, function.evaluate(StyleCalculationParameters(4)));
+    EXPECT_EQ(8, function.evaluate(StyleCalculationParameters(6)));
+    EXPECT_EQ(10, function.evaluate(StyleCalculationParameters(9)));
+
+    // Of several stops at the same zoom level, the first one applies.
+    mbgl::Function<float> duplicate({ { 0, 1 }, { 4, 2 }, { 4, 3 }, { 8, 4 }, { 8, 5 } }, 1);
+    EXPECT_EQ(1, duplicate.evaluate(StyleCalculationParameters(0)));
+    EXPECT_EQ(1.5, duplicate.evaluate(StyleCalculationParameters(2)));
+    EXPECT_EQ(2, duplicate.evaluate(StyleCalculationParameters(4)));
+    EXPECT_EQ(3, duplicate.evaluate(StyleCalculationParameters(6)));
+    EXPECT_EQ(4, duplicate.evaluate(StyleCalculationParameters(8)));
+    EXPECT_EQ(4, duplicate.evaluate(StyleCalculationParameters(10)));
+}
+
+namespace {
+
+struct TestFeature {
+    std::unordered_map<std::string, Value> properties;
+
+    const Value* findValue(const std::string& key) const {
+        auto it = properties.find(key);
+        return it == properties.end() ? nullptr : &it->second;
+    }
+};
+
+} // namespace
+
+TEST(Function, PropertyFunction) {
+    JSDocument document;
+    document.Parse<0>(R"JSON({
+        "property": "class",
+        "stops": [["park", "#00ff00"], ["water", "#0000ff"], [3, "#ff0000"]],
+        "default": "rgba(0, 0, 0, 0.5)"
+    })JSON");
+    ASSERT_FALSE(document.HasParseError());
+
+    auto function = parseProperty<PropertyFunction<Color>>("fill-color", document);
+    ASSERT_TRUE(bool(function));
+    EXPECT_EQ("class", function->getProperty());
+    EXPECT_EQ(3u, function->getStops().size());
+
+    EXPECT_EQ((Color{{ 0, 1, 0, 1 }}), function->evaluate(TestFeature { {{ "class", std::string("park") }} }));
+    EXPECT_EQ((Color{{ 0, 0, 1, 1 }}), function->evaluate(TestFeature { {{ "class", std::string("water") }} }));
+    EXPECT_EQ((Color{{ 1, 0, 0, 1 }}), function->evaluate(TestFeature { {{ "class", uint64_t(3) }} }));
+    EXPECT_EQ((Color{{ 1, 0, 0, 1 }}), function->evaluate(TestFeature { {{ "class", 3.0 }} }));
+    EXPECT_EQ((Color{{ 0, 0, 0, 0.5 }}), function->evaluate(TestFeature { {{ "class", std::string("road") }} }));
+    EXPECT_EQ((Color{{ 0, 0, 0, 0.5 }}), function->evaluate(TestFeature {}));
+
+    // Without a default, features that match no stop get fill-color's default instead of a
+    // transparent color, which would make the whole layer translucent.
+    JSDocument noDefault;
+    noDefault.Parse<0>(R"JSON({ "property": "class", "stops": [["park", "#00ff00"], ["park", "#ff0000"], [true, "#0000ff"]] })JSON");
+    ASSERT_FALSE(noDefault.HasParseError());
+    auto withoutDefault = parseProperty<PropertyFunction<Color>>("fill-color", noDefault);
+    ASSERT_TRUE(bool(withoutDefault));
+    EXPECT_EQ((Color{{ 0, 0, 0, 1 }}), withoutDefault->getDefault());
+    EXPECT_EQ((Color{{ 0, 0, 0, 1 }}), withoutDefault->evaluate(TestFeature { {{ "class", std::string("road") }} }));
+
+    // The first of several stops with the same value wins, and booleans only match booleans.
+    EXPECT_EQ((Color{{ 0, 1, 0, 1 }}), withoutDefault->evaluate(TestFeature { {{ "class", std::string("park") }} }));
+    EXPECT_EQ((Color{{ 0, 0, 1, 1 }}), withoutDefault->evaluate(TestFeature { {{ "class", true }} }));
+    EXPECT_EQ((Color{{ 0, 0, 0, 1 }}), withoutDefault->evaluate(TestFeature { {{ "class", uint64_t(1) }} }));
+
+    // Zoom functions ignore property functions.
+    EXPECT_FALSE(bool(parseProperty<Function<Color>>("fill-color", document)));
+}
@@ -4,6 +4,7 @@
 #include <mbgl/test/stub_style_observer.hpp>
 
 #include <mbgl/source/source.hpp>
+#include <mbgl/tile/tile.hpp>
 #include <mbgl/util/run_loop.hpp>
 #include <mbgl/util/string.hpp>
 #include <mbgl/util/io.hpp>
@@ -346,3 +347,136 @@ TEST(Source, VectorTileCancel) {
 
     test.run();
 }
+
+TEST(Source, CoveringTilesUntilUploaded) {
+    SourceTest test;
+
+    test.fileSource.tileResponse = [&] (const Resource&) {
+        Response response;
+        response.noContent = true;
+        return response;
+    };
+
+    test.observer.tileError = [&] (Source&, const TileID&, std::exception_ptr) {
+        FAIL() << "Should never be called";
+    };
+
+    auto info = std::make_unique<SourceInfo>();
+    info->tiles = { "tiles" };
+
+    Source source(SourceType::Vector, "source", "", 512, std::move(info), nullptr);
+    source.setObserver(&test.observer);
+    source.load(test.fileSource);
+
+    auto update = [&] {
+        test.updateParameters.animationTime += Seconds(1);
+        source.update(test.updateParameters);
+    };
+
+    auto tilesAtZoom = [&] (uint8_t z) {
+        size_t count = 0;
+        for (const auto& tile : source.getTiles()) {
+            if (tile->id.z == z) {
+                count++;
+            }
+        }
+        return count;
+    };
+
+    // Load the tile at z0 and hand it to the painter.
+    test.observer.tileLoaded = [&] (Source&, const TileID&, bool) {
+        test.end();
+    };
+    update();
+    test.run();
+
+    ASSERT_EQ(1u, source.getTiles().size());
+    source.getTiles().front()->data->uploaded = true;
+
+    // Zoom in and load the four children.
+    test.transform.setLatLngZoom({0, 0}, 1);
+    test.transformState = test.transform.getState();
+
+    size_t loaded = 0;
+    test.observer.tileLoaded = [&] (Source&, const TileID&, bool) {
+        if (++loaded == 4) {
+            test.end();
+        }
+    };
+    update();
+    test.run();
+
+    // The children are loaded, but can't be drawn before they are uploaded, so the parent
+    // keeps covering them.
+    update();
+    EXPECT_EQ(4u, tilesAtZoom(1));
+    EXPECT_EQ(1u, tilesAtZoom(0));
+
+    // Once they were uploaded, the next update drops the parent.
+    for (const auto& tile : source.getTiles()) {
+        tile->data->uploaded = true;
+    }
+    update();
+    EXPECT_EQ(4u, tilesAtZoom(1));
+    EXPECT_EQ(0u, tilesAtZoom(0));
+}
+
+TEST(Source, TilePriority) {
+    SourceTest test;
+
+    // Serves the z0 tile, but holds back the z1 tiles so that the z0 tile keeps standing in
+    // for them. Ends the run loop once the z0 tile request has the expected priority.
+    optional<Resource::Priority> parentPriority;
+    test.fileSource.tileResponse = [&] (const Resource& resource) -> optional<Response> {
+        if (resource.url != "0-0-0") {
+            EXPECT_EQ(Resource::Priority::Regular, resource.priority) << resource.url;
+            return {};
+        }
+
+        if (parentPriority && resource.priority == *parentPriority) {
+            test.end();
+        }
+
+        Response response;
+        response.noContent = true;
+        return response;
+    };
+
+    test.observer.tileError = [&] (Source&, const TileID&, std::exception_ptr) {
+        FAIL() << "Should never be called";
+    };
+
+    auto info = std::make_unique<SourceInfo>();
+    info->tiles = { "{z}-{x}-{y}" };
+
+    Source source(SourceType::Vector, "source", "", 512, std::move(info), nullptr);
+    source.setObserver(&test.observer);
+    source.load(test.fileSource);
+
+    auto update = [&] (double zoom) {
+        test.transform.setLatLngZoom({0, 0}, zoom);
+        test.transformState = test.transform.getState();
+        test.updateParameters.animationTime += Seconds(1);
+        source.update(test.updateParameters);
+    };
+
+    test.observer.tileLoaded = [&] (Source&, const TileID&, bool) {
+        test.end();
+    };
+    update(0);
+    test.run();
+    test.observer.tileLoaded = nullptr;
+
+    // Zooming in leaves the z0 tile out of the ideal cover; its request goes behind the
+    // requests for the z1 tiles.
+    parentPriority = Resource::Priority::Low;
+    update(1);
+    test.run();
+    EXPECT_EQ(5u, source.getTiles().size());
+
+    // Zooming back out makes it ideal again, and cancels the requests for the z1 tiles.
+    parentPriority = Resource::Priority::Regular;
+    update(0);
+    test.run();
+    EXPECT_EQ(1u, source.getTiles().size());
+}
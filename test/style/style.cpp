@@ -1,10 +1,20 @@
 #include <mbgl/test/util.hpp>
 #include <mbgl/test/stub_file_source.hpp>
+#include <mbgl/test/stub_style_observer.hpp>
+#include <mbgl/test/mock_view.hpp>
 
 #include <mbgl/map/map_data.hpp>
+#include <mbgl/map/transform.hpp>
 #include <mbgl/style/style.hpp>
+#include <mbgl/layer/background_layer.hpp>
+#include <mbgl/tile/tile.hpp>
+#include <mbgl/tile/tile_data.hpp>
+#include <mbgl/gl/texture_pool.hpp>
+#include <mbgl/util/run_loop.hpp>
 #include <mbgl/util/io.hpp>
 
+#include <set>
+
 using namespace mbgl;
 
 TEST(Style, UnusedSource) {
@@ -66,3 +76,239 @@ TEST(Style, UnusedSourceActiveViaClassUpdate) {
     EXPECT_TRUE(unusedSource);
     EXPECT_FALSE(unusedSource->isLoaded());
 }
+
+TEST(Style, LayerSnapshot) {
+    util::RunLoop loop;
+    util::ThreadContext context { "Map", util::ThreadType::Map, util::ThreadPriority::Regular };
+    util::ThreadContext::Set(&context);
+
+    MapData data { MapMode::Still, GLContextMode::Unique, 1.0 };
+    StubFileSource fileSource;
+    Style style { data, fileSource };
+
+    style.setJSON(util::read_file("test/fixtures/resources/style-unused-sources.json"), "");
+
+    // Tiles share the snapshot until the layers change.
+    StyleLayerSnapshot snapshot = style.getLayerSnapshot();
+    ASSERT_TRUE(snapshot);
+    EXPECT_EQ(snapshot, style.getLayerSnapshot());
+
+    auto now = Clock::now();
+    style.cascade(now);
+    style.recalculate(0, now);
+    EXPECT_EQ(snapshot, style.getLayerSnapshot());
+
+    const std::string id = snapshot->front()->id;
+    style.removeLayer(id);
+    StyleLayerSnapshot removed = style.getLayerSnapshot();
+    EXPECT_NE(snapshot, removed);
+    EXPECT_EQ(snapshot->size() - 1, removed->size());
+
+    // Snapshots that are still in use aren't affected.
+    EXPECT_EQ(id, snapshot->front()->id);
+}
+
+TEST(Style, LayerIndex) {
+    util::RunLoop loop;
+    util::ThreadContext context { "Map", util::ThreadType::Map, util::ThreadPriority::Regular };
+    util::ThreadContext::Set(&context);
+
+    MapData data { MapMode::Still, GLContextMode::Unique, 1.0 };
+    StubFileSource fileSource;
+    Style style { data, fileSource };
+
+    style.setJSON(util::read_file("test/fixtures/resources/style-unused-sources.json"), "");
+
+    StyleLayer* used = style.getLayer("usedlayer");
+    ASSERT_TRUE(used);
+    EXPECT_EQ("usedlayer", used->id);
+    EXPECT_FALSE(style.getLayer("missinglayer"));
+
+    auto background = std::make_unique<BackgroundLayer>();
+    background->id = "background";
+    StyleLayer* added = background.get();
+    style.addLayer(std::move(background), std::string("usedlayer"));
+    EXPECT_EQ(added, style.getLayer("background"));
+    EXPECT_EQ("background", style.getLayerSnapshot()->front()->id);
+
+    style.removeLayer("background");
+    EXPECT_FALSE(style.getLayer("background"));
+    EXPECT_EQ(used, style.getLayer("usedlayer"));
+
+    EXPECT_TRUE(style.getSource("usedsource"));
+    EXPECT_FALSE(style.getSource("missingsource"));
+}
+
+namespace {
+
+const char* renderOrderStyle = R"STYLE({
+  "version": 8,
+  "sources": {
+    "vectorsource": {
+      "type": "vector",
+      "tiles": [ "{z}-{x}-{y}" ]
+    }
+  },
+  "layers": [{
+    "id": "road",
+    "type": "line",
+    "source": "vectorsource",
+    "source-layer": "road"
+  }]
+})STYLE";
+
+// Loads the tiles of renderOrderStyle through the style. Every tile is served once, unless it
+// is served again with serve().
+class RenderOrderTest {
+public:
+    util::RunLoop loop;
+    util::ThreadContext context { "Map", util::ThreadType::Map, util::ThreadPriority::Regular };
+    MapData data { MapMode::Still, GLContextMode::Unique, 1.0 };
+    StubFileSource fileSource;
+    StubStyleObserver observer;
+    MockView view;
+    Transform transform { view, ConstrainMode::HeightOnly };
+    gl::TexturePool texturePool;
+    Style style { data, fileSource };
+
+    std::set<std::string> served;
+    bool noContent = false;
+
+    RenderOrderTest() {
+        util::ThreadContext::Set(&context);
+
+        transform.resize({{ 512, 512 }});
+        transform.setLatLngZoom({0, 0}, 0);
+
+        fileSource.tileResponse = [&] (const Resource& resource) -> optional<Response> {
+            if (!served.insert(resource.url).second) {
+                return {};
+            }
+            Response response;
+            if (noContent) {
+                response.noContent = true;
+            } else {
+                response.data = std::make_shared<std::string>(util::read_file("test/fixtures/resources/vector.pbf"));
+            }
+            return response;
+        };
+
+        style.setObserver(&observer);
+        style.setJSON(renderOrderStyle, "");
+    }
+
+    void update() {
+        const auto now = Clock::now();
+        style.cascade(now);
+        style.recalculate(transform.getZoom(), now);
+        style.update(transform.getState(), now, texturePool);
+    }
+
+    // Updates the style and runs until the given number of tiles were (re)loaded.
+    void load(size_t count) {
+        size_t loaded = 0;
+        observer.tileLoaded = [&] (Source&, const TileID&, bool) {
+            if (++loaded == count) {
+                loop.stop();
+            }
+        };
+        update();
+        loop.run();
+        observer.tileLoaded = nullptr;
+    }
+
+    // Serves the tile again, which makes it parse the response and replace its buckets.
+    void serve(const std::string& url) {
+        served.erase(url);
+    }
+};
+
+} // namespace
+
+TEST(Style, RenderOrderBucketReplaced) {
+    RenderOrderTest test;
+    test.load(1);
+
+    RenderData first = test.style.getRenderData();
+    ASSERT_EQ(1u, first.order->size());
+    const Tile* tile = first.order->at(0).tile;
+    ASSERT_TRUE(tile);
+    EXPECT_EQ(tile->data->getBucket(first.order->at(0).layer), first.order->at(0).bucket);
+    const uint64_t version = tile->data->getBucketsVersion();
+
+    // Until something changes, every frame shares the same render order.
+    EXPECT_EQ(first.order, test.style.getRenderData().order);
+
+    // The same tile reparses the same data into new buckets.
+    test.serve("0-0-0");
+    test.load(1);
+    EXPECT_NE(version, tile->data->getBucketsVersion());
+
+    RenderData replaced = test.style.getRenderData();
+    ASSERT_EQ(1u, replaced.order->size());
+    EXPECT_EQ(tile, replaced.order->at(0).tile);
+    EXPECT_EQ(tile->data->getBucket(replaced.order->at(0).layer), replaced.order->at(0).bucket);
+
+    // An empty response drops the buckets; the tile is still ready, but has nothing to draw.
+    test.noContent = true;
+    test.serve("0-0-0");
+    test.load(1);
+    ASSERT_TRUE(tile->data->isReady());
+    EXPECT_TRUE(test.style.getRenderData().order->empty());
+}
+
+TEST(Style, RenderOrderTileReplaced) {
+    RenderOrderTest test;
+    test.load(1);
+
+    RenderData first = test.style.getRenderData();
+    ASSERT_EQ(1u, first.order->size());
+    const uint64_t version = first.order->at(0).tile->data->getBucketsVersion();
+
+    // Zoom in until the four children replace the tile, and drop it from the cache.
+    test.transform.setLatLngZoom({0, 0}, 1);
+    test.load(4);
+    test.update();
+    test.style.onLowMemory();
+    EXPECT_EQ(4u, test.style.getRenderData().order->size());
+
+    // Zooming out loads the tile from scratch. The new tile and its data are typically
+    // allocated where the old ones were, so only the buckets version tells them apart.
+    test.transform.setLatLngZoom({0, 0}, 0);
+    test.serve("0-0-0");
+    test.load(1);
+    test.update();
+
+    RenderData reloaded = test.style.getRenderData();
+    ASSERT_EQ(1u, reloaded.order->size());
+    const Tile* tile = reloaded.order->at(0).tile;
+    EXPECT_EQ(TileID(0, 0, 0, 0), tile->id);
+    EXPECT_NE(version, tile->data->getBucketsVersion());
+    EXPECT_EQ(tile->data->getBucket(reloaded.order->at(0).layer), reloaded.order->at(0).bucket);
+}
+
+TEST(Style, RenderOrderLayerAddedRemoved) {
+    RenderOrderTest test;
+    test.load(1);
+    ASSERT_EQ(1u, test.style.getRenderData().order->size());
+
+    // Backgrounds above other layers are drawn as layers of their own.
+    auto background = std::make_unique<BackgroundLayer>();
+    background->id = "background";
+    const StyleLayer* added = background.get();
+    test.style.addLayer(std::move(background));
+
+    RenderData withBackground = test.style.getRenderData();
+    ASSERT_EQ(2u, withBackground.order->size());
+    EXPECT_EQ("road", withBackground.order->at(0).layer.id);
+    EXPECT_EQ(added, &withBackground.order->at(1).layer);
+
+    test.style.removeLayer("background");
+    RenderData withoutBackground = test.style.getRenderData();
+    ASSERT_EQ(1u, withoutBackground.order->size());
+    EXPECT_EQ("road", withoutBackground.order->at(0).layer.id);
+
+    // No item refers to the removed layer anymore.
+    test.style.removeLayer("road");
+    EXPECT_TRUE(test.style.getRenderData().order->empty());
+}
@@ -1,7 +1,12 @@
 #include <mbgl/test/util.hpp>
+#include <mbgl/test/fixture_log_observer.hpp>
 
 #include <mbgl/style/style_layer.hpp>
 #include <mbgl/layer/background_layer.hpp>
+#include <mbgl/layer/fill_layer.hpp>
+#include <mbgl/style/property_transition.hpp>
+#include <mbgl/style/style_cascade_parameters.hpp>
+#include <mbgl/style/style_calculation_parameters.hpp>
 
 using namespace mbgl;
 
@@ -22,3 +27,95 @@ TEST(StyleLayer, CloneCopiesBaseProperties) {
     layer->id = "test";
     EXPECT_EQ("test", layer->clone()->id);
 }
+
+TEST(StyleLayer, RecalculateIfNeeded) {
+    BackgroundLayer layer;
+    layer.paint.opacity.values.emplace(ClassID::Default, Function<float>({ { 0, 0.5f }, { 2, 1.0f } }, 1));
+
+    const TimePoint now = Clock::now();
+    layer.cascade({ { ClassID::Default, ClassID::Fallback }, now, PropertyTransition() });
+
+    StyleCalculationParameters parameters(1);
+    parameters.now = now;
+    parameters.defaultFadeDuration = Duration::zero();
+
+    EXPECT_FALSE(layer.recalculateIfNeeded(parameters));
+    EXPECT_FLOAT_EQ(0.75f, layer.paint.opacity);
+
+    // Nothing changed, so the calculated value stays.
+    layer.paint.opacity.value = 0;
+    layer.recalculateIfNeeded(parameters);
+    EXPECT_FLOAT_EQ(0.0f, layer.paint.opacity);
+
+    parameters.z = 2;
+    layer.recalculateIfNeeded(parameters);
+    EXPECT_FLOAT_EQ(1.0f, layer.paint.opacity);
+
+    layer.paint.opacity.value = 0;
+    layer.invalidateCalculation();
+    layer.recalculateIfNeeded(parameters);
+    EXPECT_FLOAT_EQ(1.0f, layer.paint.opacity);
+}
+
+TEST(StyleLayer, PaintTransitions) {
+    BackgroundLayer layer;
+    auto& opacity = layer.paint.opacity;
+    opacity.values.emplace(ClassID::Default, Function<float>(0.0f));
+    opacity.values.emplace(ClassID::Named, Function<float>(0.5f));
+
+    const TimePoint now = Clock::now();
+    StyleCalculationParameters parameters(0);
+    parameters.now = now;
+
+    opacity.cascade({ { ClassID::Default, ClassID::Fallback }, now, PropertyTransition() });
+    EXPECT_FALSE(opacity.calculate(parameters));
+    EXPECT_FLOAT_EQ(0.0f, opacity);
+
+    opacity.cascade({ { ClassID::Named, ClassID::Default, ClassID::Fallback }, now, PropertyTransition(std::chrono::seconds(1)) });
+    parameters.now = now + std::chrono::milliseconds(500);
+    EXPECT_TRUE(opacity.calculate(parameters));
+    EXPECT_FLOAT_EQ(0.25f, opacity);
+
+    // Transition back to the fallback value while the first transition is still running.
+    opacity.cascade({ { ClassID::Fallback }, parameters.now, PropertyTransition(std::chrono::seconds(1)) });
+    parameters.now = now + std::chrono::milliseconds(1000);
+    EXPECT_TRUE(opacity.calculate(parameters));
+    EXPECT_FLOAT_EQ(0.75f, opacity);
+    EXPECT_EQ(2u, opacity.cascaded.size());
+
+    // Completed transitions are dropped.
+    parameters.now = now + std::chrono::milliseconds(2000);
+    EXPECT_FALSE(opacity.calculate(parameters));
+    EXPECT_FLOAT_EQ(1.0f, opacity);
+    EXPECT_EQ(1u, opacity.cascaded.size());
+}
+
+TEST(StyleLayer, FillColorPropertyFunctionInClass) {
+    FixtureLogObserver* observer = new FixtureLogObserver();
+    Log::setObserver(std::unique_ptr<Log::Observer>(observer));
+
+    JSDocument document;
+    document.Parse<0>(R"JSON({
+        "paint": {
+            "fill-color": { "property": "class", "stops": [["park", "#00ff00"]], "default": "red" }
+        },
+        "paint.night": {
+            "fill-color": { "property": "class", "stops": [["park", "#003300"]], "default": "black" }
+        }
+    })JSON");
+    ASSERT_FALSE(document.HasParseError());
+
+    FillLayer layer;
+    layer.parsePaints(document);
+
+    // Only the default class sets the per-feature colors; the other one is reported.
+    ASSERT_TRUE(bool(layer.paint.featureColor));
+    EXPECT_EQ((Color{{ 1, 0, 0, 1 }}), layer.paint.featureColor->getDefault());
+
+    EXPECT_EQ(1u, observer->count({
+        EventSeverity::Warning,
+        Event::ParseStyle,
+        -1,
+        "'fill-color' property functions are only supported in the default paint class; ignoring the one in 'paint.night'"
+    }));
+}
@@ -409,3 +409,66 @@ TEST(ClipIDs, SecondSourceHasParentOfFirstSource) {
     ASSERT_EQ(Stencil(TileID{ 1, 0, 0, 1 }, { "00000111", "00000101"}), *it++);
     ASSERT_EQ(stencils.end(), it);
 }
+
+TEST(ClipIDs, CacheReusesIDs) {
+    auto loaded = [](const std::vector<std::vector<std::shared_ptr<Tile>>>& sources) {
+        std::vector<std::forward_list<Tile *>> result;
+        for (const auto& tiles : sources) {
+            result.emplace_back();
+            std::transform(tiles.begin(), tiles.end(), std::front_inserter(result.back()), [](const std::shared_ptr<Tile> &tile) { return tile.get(); });
+        }
+        return result;
+    };
+
+    const std::vector<std::vector<std::shared_ptr<Tile>>> sources = {
+        {
+            std::make_shared<Tile>(TileID { 1, 0, 0, 1 }),
+            std::make_shared<Tile>(TileID { 1, 0, 1, 1 }),
+            std::make_shared<Tile>(TileID { 0, 0, 0, 0 }),
+        },
+        {
+            std::make_shared<Tile>(TileID { 1, 1, 0, 1 }),
+        },
+    };
+
+    ClipIDCache cache;
+    ASSERT_TRUE(cache.update(loaded(sources)));
+
+    ClipIDGenerator generator;
+    generate(generator, sources);
+    EXPECT_EQ(generator.getStencils(), cache.getStencils());
+    const ClipID clip = sources[0][0]->clip;
+
+    // The same tiles keep their IDs without generating them again.
+    sources[0][0]->clip = ClipID();
+    EXPECT_FALSE(cache.update(loaded(sources)));
+    EXPECT_EQ(clip, sources[0][0]->clip);
+    EXPECT_EQ(generator.getStencils(), cache.getStencils());
+
+    // So does a tile that was replaced by one with the same ID.
+    const std::vector<std::vector<std::shared_ptr<Tile>>> replaced = {
+        { std::make_shared<Tile>(TileID { 1, 0, 0, 1 }), sources[0][1], sources[0][2] },
+        sources[1],
+    };
+    EXPECT_FALSE(cache.update(loaded(replaced)));
+    EXPECT_EQ(clip, replaced[0][0]->clip);
+
+    // Loading another tile changes the IDs.
+    const std::vector<std::vector<std::shared_ptr<Tile>>> added = {
+        sources[0],
+        { sources[1][0], std::make_shared<Tile>(TileID { 1, 1, 1, 1 }) },
+    };
+    EXPECT_TRUE(cache.update(loaded(added)));
+    EXPECT_EQ(4u, cache.getStencils().size());
+
+    // So does moving a tile to another source.
+    const std::vector<std::vector<std::shared_ptr<Tile>>> moved = {
+        { sources[0][0], sources[0][1], sources[0][2], sources[1][0] },
+        { added[1][1] },
+    };
+    EXPECT_TRUE(cache.update(loaded(moved)));
+
+    // And unloading tiles.
+    EXPECT_TRUE(cache.update(loaded(sources)));
+    EXPECT_EQ(generator.getStencils(), cache.getStencils());
+}
@@ -93,6 +93,28 @@ TEST(TileCover, SanFranciscoZ10) {
         }));
 }
 
+TEST(TileCover, TileCount) {
+    const LatLngBounds bounds[] = {
+        LatLngBounds::empty(),
+        LatLngBounds::world(),
+        LatLngBounds::hull({ 86, -180 }, { 90, 180 }),
+        LatLngBounds::hull({ -45, -90 }, { 45, 90 }),
+        LatLngBounds::hull({ 0, 0 }, { 10, 0 }),
+        LatLngBounds::hull({ 0, 0 }, { 0, 10 }),
+        LatLngBounds::hull({ 37.6609, -122.5744 + 360 }, { 37.8271, -122.3204 + 360 }),
+        sanFrancisco,
+    };
+
+    for (const auto& b : bounds) {
+        for (int32_t z = 0; z <= 6; z++) {
+            EXPECT_EQ(tileCover(b, z, z).size(), tileCount(b, z));
+        }
+    }
+
+    EXPECT_EQ(4u, tileCount(sanFrancisco, 10));
+    EXPECT_EQ(tileCover(sanFrancisco, 16, 16).size(), tileCount(sanFrancisco, 16));
+}
+
 //TEST(TileCover, OrderedByDistanceToCenter) {
 //    auto result = tileCover(sanFrancisco, 12, 12);
 //    ASSERT_EQ(12, result.size());
@@ -48,3 +48,21 @@ TEST(Token, replaceTokens) {
         return "";
     }));
 }
+
+TEST(Token, TokenString) {
+    const auto lookup = [](const std::string& token) -> std::string {
+        if (token == "name") return "14th St NW";
+        if (token == "num") return "1400";
+        if (token == "") return "empty";
+        return "";
+    };
+
+    for (const std::string source : { "literal", "{name}", "{num} m", "{name} {num} {unset}", "{}",
+                                      "{name", "a{b{num}", "{num}}", "}{name}{", "{HØYDE} m", "" }) {
+        std::string result = "prefix ";
+        util::TokenString(source).appendTo(result, [&](const std::string& token, std::string& out) {
+            out += lookup(token);
+        });
+        EXPECT_EQ("prefix " + util::replaceTokens(source, lookup), result) << source;
+    }
+}